@@ -0,0 +1,95 @@
+#include "affine34.h"
+#include "math.h"
+
+GF_NAMESPACE_BEGIN
+
+const Affine34 Affine34::IDENTITY(
+    1, 0, 0, 0,
+    0, 1, 0, 0,
+    0, 0, 1, 0
+    );
+
+Affine34 Affine34::inverse() const
+{
+    // Storage is x' = L x + t with column vectors, so the inverse is (L^-1, -L^-1 t).
+    const auto& m = m_;
+    const auto c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    const auto c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    const auto c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    const auto det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+    check(!equalf(det, 0));
+    const auto invDet = 1 / det;
+
+    Affine34 r;
+    r.m_[0][0] = c00 * invDet;
+    r.m_[1][0] = c01 * invDet;
+    r.m_[2][0] = c02 * invDet;
+    r.m_[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+    r.m_[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+    r.m_[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+    r.m_[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+    r.m_[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+    r.m_[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        r.m_[i][3] = -(r.m_[i][0] * m[0][3] + r.m_[i][1] * m[1][3] + r.m_[i][2] * m[2][3]);
+    }
+    return r;
+}
+
+bool operator ==(const Affine34& a, const Affine34& b)
+{
+    for (int i = 0; i < 12; ++i)
+    {
+        if (!equalf(a.data()[i], b.data()[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool operator !=(const Affine34& a, const Affine34& b)
+{
+    return !(a == b);
+}
+
+const Affine34 operator *(const Affine34& a, const Affine34& b)
+{
+    // In storage terms the product is b's rows applied to a, plus b's translation
+    const auto x = a.data();
+    const auto y = b.data();
+    Affine34 r;
+    const auto z = r.data();
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto yi = y + i * 4;
+        for (int j = 0; j < 4; ++j)
+        {
+            z[i * 4 + j] = yi[0] * x[j] + yi[1] * x[4 + j] + yi[2] * x[8 + j];
+        }
+        z[i * 4 + 3] += yi[3];
+    }
+    return r;
+}
+
+Affine34 makeTransformAffine(const Vector3& scale, const Quaternion& rot, const Vector3& trans)
+{
+    auto q = rot;
+    q.normalize();
+
+    const auto x2 = q.x * 2;
+    const auto y2 = q.y * 2;
+    const auto z2 = q.z * 2;
+    const auto w2 = q.w * 2;
+
+    // Rows of the Matrix44 rotation scaled by the axis, then transposed into storage
+    return Affine34(
+        (1 - y2 * q.y - z2 * q.z) * scale.x, (x2 * q.y - w2 * q.z) * scale.y, (x2 * q.z + w2 * q.y) * scale.z, trans.x,
+        (x2 * q.y + w2 * q.z) * scale.x, (1 - x2 * q.x - z2 * q.z) * scale.y, (y2 * q.z - w2 * q.x) * scale.z, trans.y,
+        (x2 * q.z - w2 * q.y) * scale.x, (y2 * q.z + w2 * q.x) * scale.y, (1 - x2 * q.x - y2 * q.y) * scale.z, trans.z
+        );
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,147 @@
+#ifndef GAMEFRIENDS_AFFINE34_H
+#define GAMEFRIENDS_AFFINE34_H
+
+#include "matrix44.h"
+#include "vector3.h"
+#include "quaternion.h"
+#include "exception.h"
+#include "prerequest.h"
+
+GF_NAMESPACE_BEGIN
+
+/// Matrix44 whose 4th column is implicitly (0, 0, 0, 1), under the same row vector convention.
+/// Stored as the transpose of the upper 4x3, so each of the 3 rows is (x, y, z, translation)
+/// of one output axis. That is the layout of an HLSL float4x3 with the default column_major
+/// packing, so data() uploads without a transpose.
+class Affine34
+{
+private:
+    float m_[3][4];
+
+public:
+    Affine34() = default;
+
+    /// Arguments in storage order
+    constexpr Affine34(
+        float n00, float n01, float n02, float n03,
+        float n10, float n11, float n12, float n13,
+        float n20, float n21, float n22, float n23
+        );
+
+    Affine34(const Affine34&) = default;
+    Affine34& operator =(const Affine34&) = default;
+
+    const float* data() const; /// 12 floats, 3 rows of 4
+    float* data();
+
+    Vector3 axis(size_t i) const; /// Row i of the equivalent Matrix44
+    Vector3 translation() const;
+    void setTranslation(const Vector3& t);
+
+    Vector3 transformPoint(const Vector3& p) const;         /// (p, 1) * m
+    Vector3 transformDirection(const Vector3& d) const;     /// (d, 0) * m
+    Affine34 inverse() const;
+
+    static const Affine34 IDENTITY;
+};
+
+bool operator ==(const Affine34& a, const Affine34& b);
+bool operator !=(const Affine34& a, const Affine34& b);
+
+/// a then b, same as Matrix44 a * b
+const Affine34 operator *(const Affine34& a, const Affine34& b);
+Affine34& operator *=(Affine34& a, const Affine34& b);
+
+Affine34 makeTransformAffine(const Vector3& scale, const Quaternion& rot, const Vector3& trans);
+
+constexpr Affine34::Affine34(
+    float n00, float n01, float n02, float n03,
+    float n10, float n11, float n12, float n13,
+    float n20, float n21, float n22, float n23
+    )
+    : m_{
+        { n00, n01, n02, n03 },
+        { n10, n11, n12, n13 },
+        { n20, n21, n22, n23 } }
+{
+}
+
+inline const float* Affine34::data() const
+{
+    return &m_[0][0];
+}
+
+inline float* Affine34::data()
+{
+    return &m_[0][0];
+}
+
+inline Vector3 Affine34::axis(size_t i) const
+{
+    check(i < 3);
+    return{ m_[0][i], m_[1][i], m_[2][i] };
+}
+
+inline Vector3 Affine34::translation() const
+{
+    return{ m_[0][3], m_[1][3], m_[2][3] };
+}
+
+inline void Affine34::setTranslation(const Vector3& t)
+{
+    m_[0][3] = t.x;
+    m_[1][3] = t.y;
+    m_[2][3] = t.z;
+}
+
+inline Vector3 Affine34::transformPoint(const Vector3& p) const
+{
+    return{
+        m_[0][0] * p.x + m_[0][1] * p.y + m_[0][2] * p.z + m_[0][3],
+        m_[1][0] * p.x + m_[1][1] * p.y + m_[1][2] * p.z + m_[1][3],
+        m_[2][0] * p.x + m_[2][1] * p.y + m_[2][2] * p.z + m_[2][3]
+    };
+}
+
+inline Vector3 Affine34::transformDirection(const Vector3& d) const
+{
+    return{
+        m_[0][0] * d.x + m_[0][1] * d.y + m_[0][2] * d.z,
+        m_[1][0] * d.x + m_[1][1] * d.y + m_[1][2] * d.z,
+        m_[2][0] * d.x + m_[2][1] * d.y + m_[2][2] * d.z
+    };
+}
+
+inline Affine34& operator *=(Affine34& a, const Affine34& b)
+{
+    a = a * b;
+    return a;
+}
+
+template <>
+inline Matrix44 to(const Affine34& a)
+{
+    const auto m = a.data();
+    return Matrix44(
+        m[0], m[4], m[8], 0,
+        m[1], m[5], m[9], 0,
+        m[2], m[6], m[10], 0,
+        m[3], m[7], m[11], 1
+        );
+}
+
+/// The 4th column of m must be (0, 0, 0, 1)
+template <>
+inline Affine34 to(const Matrix44& m)
+{
+    check(equalf(m(0, 3), 0) && equalf(m(1, 3), 0) && equalf(m(2, 3), 0) && equalf(m(3, 3), 1));
+    return Affine34(
+        m(0, 0), m(1, 0), m(2, 0), m(3, 0),
+        m(0, 1), m(1, 1), m(2, 1), m(3, 1),
+        m(0, 2), m(1, 2), m(2, 2), m(3, 2)
+        );
+}
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
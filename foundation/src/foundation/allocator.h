@@ -0,0 +1,117 @@
+#ifndef GAMEFRIENDS_ALLOCATOR_H
+#define GAMEFRIENDS_ALLOCATOR_H
+
+#include "prerequest.h"
+#include <memory>
+#include <limits>
+#include <new>
+#include <cstring>
+#include <cstddef>
+
+/// Fill fresh and released memory with recognizable bytes. Defaults to on in debug builds.
+#ifndef GF_ALLOCATOR_POISON
+    #ifdef GF_DEBUG
+        #define GF_ALLOCATOR_POISON 1
+    #else
+        #define GF_ALLOCATOR_POISON 0
+    #endif
+#endif
+
+GF_NAMESPACE_BEGIN
+
+struct AllocatorStats
+{
+    size_t used; /// Bytes handed out, including alignment padding
+    size_t highWater; /// Peak of used
+    size_t capacity; /// Bytes reserved from the system
+    size_t allocations; /// Number of allocate() calls
+};
+
+namespace detail
+{
+    const uint8 POISON_ALLOCATED = 0xcd;
+    const uint8 POISON_RELEASED = 0xdd;
+
+    inline void poison(void* p, size_t size, uint8 byte)
+    {
+#if GF_ALLOCATOR_POISON
+        std::memset(p, byte, size);
+#else
+        (void)p;
+        (void)size;
+        (void)byte;
+#endif
+    }
+
+    inline size_t alignUp(size_t n, size_t alignment)
+    {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+/// std::allocator compatible adaptor over ArenaAllocator, FrameAllocator or PoolAllocator.
+/// Copies share the referenced allocator, which must outlive every container using it.
+template <class T, class Resource>
+class StdAllocator
+{
+private:
+    template <class U, class R>
+    friend class StdAllocator;
+
+    Resource* resource_;
+
+public:
+    using value_type = T;
+
+    template <class U>
+    struct rebind
+    {
+        using other = StdAllocator<U, Resource>;
+    };
+
+    explicit StdAllocator(Resource& resource) noexcept
+        : resource_(&resource)
+    {
+    }
+
+    template <class U>
+    StdAllocator(const StdAllocator<U, Resource>& that) noexcept
+        : resource_(that.resource_)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        resource_->deallocate(p, n * sizeof(T));
+    }
+
+    Resource& resource() const noexcept
+    {
+        return *resource_;
+    }
+
+    template <class U>
+    bool operator ==(const StdAllocator<U, Resource>& that) const noexcept
+    {
+        return resource_ == that.resource_;
+    }
+
+    template <class U>
+    bool operator !=(const StdAllocator<U, Resource>& that) const noexcept
+    {
+        return resource_ != that.resource_;
+    }
+};
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
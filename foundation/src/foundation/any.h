@@ -8,6 +8,7 @@
 #include <memory>
 #include <typeinfo>
 #include <string>
+#include <new>
 
 GF_NAMESPACE_BEGIN
 
@@ -18,63 +19,120 @@ public:
         : Exception(msg) {}
 };
 
+/// Values up to 3 pointers in size with a noexcept move are stored inline, others on the heap.
+/// The per-type operation table doubles as the type tag, so cast() needs no RTTI.
 class Any
 {
 private:
-    struct Holder
+    static const size_t BUFFER_SIZE = sizeof(void*) * 3;
+
+    union Storage
+    {
+        void* heap;
+        std::aligned_storage_t<BUFFER_SIZE, alignof(void*)> buffer;
+    };
+
+    template <class T>
+    using IsInline = std::integral_constant<bool,
+        sizeof(T) <= BUFFER_SIZE &&
+        alignof(T) <= alignof(Storage) &&
+        std::is_nothrow_move_constructible<T>::value>;
+
+    struct Ops
     {
-        virtual ~Holder() noexcept = default;
-        virtual Holder* copy() const = 0;
-        virtual const std::type_info& type() const noexcept = 0;
+        void (*copy)(Storage& dest, const Storage& src);
+        void (*move)(Storage& dest, Storage& src) noexcept; /// Leaves src empty; null means a bitwise copy will do
+        void (*destroy)(Storage& s) noexcept;
+        const std::type_info& (*type)() noexcept;
+    };
+
+    template <class T, bool = IsInline<T>::value>
+    struct Manager
+    {
+        static T* get(Storage& s) noexcept { return reinterpret_cast<T*>(&s.buffer); }
+        static const T* get(const Storage& s) noexcept { return reinterpret_cast<const T*>(&s.buffer); }
+
+        template <class U>
+        static void create(Storage& s, U&& value) { new (&s.buffer) T(std::forward<U>(value)); }
+
+        static void copy(Storage& dest, const Storage& src) { create(dest, *get(src)); }
+
+        static void move(Storage& dest, Storage& src) noexcept
+        {
+            new (&dest.buffer) T(std::move(*get(src)));
+            get(src)->~T();
+        }
+
+        static constexpr auto MOVE = std::is_trivially_copyable<T>::value ? nullptr : &move;
+
+        static void destroy(Storage& s) noexcept { get(s)->~T(); }
+        static const std::type_info& type() noexcept { return typeid(T); }
+
+        static const Ops OPS;
     };
 
     template <class T>
-    struct TypedHolder : Holder
+    struct Manager<T, false>
     {
-        T value;
+        static T* get(Storage& s) noexcept { return static_cast<T*>(s.heap); }
+        static const T* get(const Storage& s) noexcept { return static_cast<const T*>(s.heap); }
 
         template <class U>
-        TypedHolder(U&& val) : value(std::forward<U>(val)) {}
-        Holder* copy() const { return new TypedHolder(value); }
-        const std::type_info& type() const noexcept { return typeid(value); }
+        static void create(Storage& s, U&& value) { s.heap = new T(std::forward<U>(value)); }
+
+        static void copy(Storage& dest, const Storage& src) { create(dest, *get(src)); }
+        static void destroy(Storage& s) noexcept { delete get(s); }
+        static const std::type_info& type() noexcept { return typeid(T); }
+
+        static const Ops OPS;
     };
 
     template <class T>
-    using TypedHolder_t = TypedHolder<std::decay_t<T>>;
+    using Manager_t = Manager<std::decay_t<T>>;
 
-    Holder* payload_;
+    Storage storage_;
+    const Ops* ops_;
 
 public:
-    Any()
-        : payload_(nullptr)
+    Any() noexcept
+        : ops_(nullptr)
     {
     }
 
     Any(const Any& that)
-        : payload_(that.payload_ ? that.payload_->copy() : nullptr)
+        : ops_(nullptr)
     {
+        if (that.ops_)
+        {
+            that.ops_->copy(storage_, that.storage_);
+            ops_ = that.ops_;
+        }
     }
 
-    Any(Any&& that)
-        : payload_(that.payload_)
+    Any(Any&& that) noexcept
+        : ops_(nullptr)
     {
-        that.payload_ = nullptr;
+        steal(that);
     }
 
-    template <class T>
+    template <class T, class = std::enable_if_t<!std::is_same<std::decay_t<T>, Any>::value>>
     Any(T&& value)
-        : payload_(new TypedHolder_t<T>(std::forward<T>(value)))
+        : ops_(nullptr)
     {
+        Manager_t<T>::create(storage_, std::forward<T>(value));
+        ops_ = &Manager_t<T>::OPS;
     }
 
     ~Any()
     {
-        delete payload_;
+        reset();
     }
 
-    void swap(Any& that)
+    void swap(Any& that) noexcept
     {
-        std::swap(payload_, that.payload_);
+        Any tmp(std::move(that));
+        that = std::move(*this);
+        *this = std::move(tmp);
     }
 
     Any& operator =(const Any& that)
@@ -83,53 +141,76 @@ public:
         return *this;
     }
 
-    Any& operator =(Any&& that)
+    Any& operator =(Any&& that) noexcept
     {
-        that.swap(*this);
+        if (this != &that)
+        {
+            reset();
+            steal(that);
+        }
         return *this;
     }
 
-    template <class T>
+    template <class T, class = std::enable_if_t<!std::is_same<std::decay_t<T>, Any>::value>>
     Any& operator =(T&& value)
     {
         Any(std::forward<T>(value)).swap(*this);
         return *this;
     }
 
-    bool hasValue() const
+    bool hasValue() const noexcept
     {
-        return !!payload_;
+        return !!ops_;
     }
 
-    const type_info& type() const
+    const std::type_info& type() const noexcept
     {
-        if (!payload_)
+        return ops_ ? ops_->type() : typeid(void);
+    }
+
+    void reset() noexcept
+    {
+        if (ops_)
         {
-            return typeid(void);
+            ops_->destroy(storage_);
+            ops_ = nullptr;
         }
-        return payload_->type();
     }
 
-    void reset()
+    template <class T>
+    T* cast() noexcept
     {
-        Any().swap(*this);
+        return ops_ == &Manager_t<T>::OPS ? Manager_t<T>::get(storage_) : nullptr;
     }
 
     template <class T>
-    T* cast()
+    const T* cast() const noexcept
     {
-        return hasValue() && type() == typeid(std::decay_t<T>) ? /// TODO: remove_cv?
-            std::addressof(static_cast<TypedHolder_t<T>*>(payload_)->value) :
-            nullptr;
+        return ops_ == &Manager_t<T>::OPS ? Manager_t<T>::get(storage_) : nullptr;
     }
 
-    template <class T>
-    const T* cast() const
+private:
+    void steal(Any& that) noexcept
     {
-        return const_cast<Any&>(*this).template cast<T>();
+        if (that.ops_ && that.ops_->move)
+        {
+            that.ops_->move(storage_, that.storage_);
+        }
+        else
+        {
+            storage_ = that.storage_;
+        }
+        ops_ = that.ops_;
+        that.ops_ = nullptr;
     }
 };
 
+template <class T, bool Inline>
+const Any::Ops Any::Manager<T, Inline>::OPS = { &copy, MOVE, &destroy, &type };
+
+template <class T>
+const Any::Ops Any::Manager<T, false>::OPS = { &copy, nullptr, &destroy, &type };
+
 template <class T>
 T* to(Any* any)
 {
@@ -0,0 +1,149 @@
+#include "arenaallocator.h"
+#include "exception.h"
+#include <algorithm>
+#include <utility>
+#include <new>
+
+GF_NAMESPACE_BEGIN
+
+ArenaAllocator::ArenaAllocator(size_t blockSize)
+    : head_(nullptr)
+    , blockSize_(blockSize)
+    , stats_()
+{
+    check(blockSize > 0);
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    release();
+}
+
+ArenaAllocator::ArenaAllocator(ArenaAllocator&& that) noexcept
+    : head_(that.head_)
+    , blockSize_(that.blockSize_)
+    , stats_(that.stats_)
+{
+    that.head_ = nullptr;
+    that.stats_ = AllocatorStats();
+}
+
+ArenaAllocator& ArenaAllocator::operator =(ArenaAllocator&& that) noexcept
+{
+    if (this != &that)
+    {
+        release();
+        head_ = that.head_;
+        blockSize_ = that.blockSize_;
+        stats_ = that.stats_;
+        that.head_ = nullptr;
+        that.stats_ = AllocatorStats();
+    }
+    return *this;
+}
+
+void* ArenaAllocator::allocate(size_t size, size_t alignment)
+{
+    // align needs be a 2-power
+    check(alignment != 0 && ((alignment - 1) & alignment) == 0);
+
+    void* p = head_ ? bump(head_, size, alignment) : nullptr;
+    if (!p)
+    {
+        pushBlock(std::max(blockSize_, size + alignment - 1));
+        p = bump(head_, size, alignment);
+        check(p);
+    }
+
+    ++stats_.allocations;
+    stats_.highWater = std::max(stats_.highWater, stats_.used);
+    detail::poison(p, size, detail::POISON_ALLOCATED);
+    return p;
+}
+
+void ArenaAllocator::deallocate(void* p, size_t size) noexcept
+{
+    check(!p || owns(p));
+    if (p)
+    {
+        detail::poison(p, size, detail::POISON_RELEASED);
+    }
+}
+
+void ArenaAllocator::reset()
+{
+    if (head_ && head_->next)
+    {
+        const auto capacity = stats_.capacity;
+        release();
+        pushBlock(capacity);
+    }
+    else if (head_)
+    {
+        detail::poison(dataOf(head_), head_->used, detail::POISON_RELEASED);
+        head_->used = 0;
+    }
+    stats_.used = 0;
+}
+
+void ArenaAllocator::release()
+{
+    while (head_)
+    {
+        const auto next = head_->next;
+        ::operator delete(head_);
+        head_ = next;
+    }
+    stats_.used = 0;
+    stats_.capacity = 0;
+}
+
+bool ArenaAllocator::owns(const void* p) const
+{
+    const auto c = static_cast<const char*>(p);
+    for (auto block = head_; block; block = block->next)
+    {
+        const auto data = dataOf(block);
+        if (c >= data && c < data + block->size)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+AllocatorStats ArenaAllocator::stats() const
+{
+    return stats_;
+}
+
+char* ArenaAllocator::dataOf(Block* block)
+{
+    return reinterpret_cast<char*>(block + 1);
+}
+
+void* ArenaAllocator::bump(Block* block, size_t size, size_t alignment)
+{
+    const auto data = reinterpret_cast<uintptr_t>(dataOf(block));
+    const auto begin = detail::alignUp(data + block->used, alignment) - data;
+    if (begin > block->size || size > block->size - begin)
+    {
+        return nullptr;
+    }
+
+    stats_.used += begin + size - block->used;
+    block->used = begin + size;
+    return dataOf(block) + begin;
+}
+
+void ArenaAllocator::pushBlock(size_t size)
+{
+    const auto block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+    block->next = head_;
+    block->size = size;
+    block->used = 0;
+    head_ = block;
+    stats_.capacity += size;
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef GAMEFRIENDS_ARENAALLOCATOR_H
+#define GAMEFRIENDS_ARENAALLOCATOR_H
+
+#include "allocator.h"
+#include "prerequest.h"
+#include <cstddef>
+
+GF_NAMESPACE_BEGIN
+
+/// Monotonic allocator. Allocations are bumped out of large blocks and released all at once by reset().
+/// deallocate() does not reclaim memory.
+class ArenaAllocator
+{
+private:
+    struct Block
+    {
+        Block* next;
+        size_t size;
+        size_t used;
+    };
+
+    Block* head_;
+    size_t blockSize_;
+    AllocatorStats stats_;
+
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit ArenaAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~ArenaAllocator();
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator =(const ArenaAllocator&) = delete;
+
+    ArenaAllocator(ArenaAllocator&& that) noexcept;
+    ArenaAllocator& operator =(ArenaAllocator&& that) noexcept;
+
+    /// alignment needs be a 2-power
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept(false);
+    void deallocate(void* p, size_t size) noexcept;
+
+    /// Rewinds to empty. Multiple blocks are merged into one so the next cycle needs no more.
+    void reset();
+
+    /// Returns all blocks to the system.
+    void release();
+
+    bool owns(const void* p) const;
+    AllocatorStats stats() const;
+
+private:
+    static char* dataOf(Block* block);
+    void* bump(Block* block, size_t size, size_t alignment);
+    void pushBlock(size_t size);
+};
+
+template <class T>
+using ArenaStdAllocator = StdAllocator<T, ArenaAllocator>;
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -1,15 +1,162 @@
 #include "axisalignedbox.h"
-#include "plane.h"
+#include "batchtransform.h"
 #include "math.h"
 #include "vector3.h"
 #include "vector4.h"
+#include "cpu.h"
 #include "exception.h"
 #include <algorithm>
-#include <array>
 #include <cfloat>
+#include <cmath>
+
+#ifdef GF_SSE
+    #include <immintrin.h>
+#endif
 
 GF_NAMESPACE_BEGIN
 
+namespace
+{
+    /// Slab test for one lane. An axis that yields NaN (parallel ray starting
+    /// exactly on a slab plane) does not constrain the interval.
+    /// min/max are written in the operand order of the SSE instructions.
+    float slab(const float (&o)[3], const float (&inv)[3], const float (&lo)[3], const float (&hi)[3])
+    {
+        auto tNear = -INFINITY;
+        auto tFar = INFINITY;
+        for (int k = 0; k < 3; ++k)
+        {
+            const auto t1 = (lo[k] - o[k]) * inv[k];
+            const auto t2 = (hi[k] - o[k]) * inv[k];
+            if (std::isnan(t1) || std::isnan(t2))
+            {
+                continue;
+            }
+            tNear = std::max(tNear, t1 < t2 ? t1 : t2);
+            tFar = std::min(tFar, t1 > t2 ? t1 : t2);
+        }
+        if (tFar < tNear || tFar < 0)
+        {
+            return -INFINITY;
+        }
+        return tNear >= 0 ? tNear : tFar;
+    }
+
+#ifdef GF_SSE
+    /// OR with the unordered mask turns the lane into NaN, and max/min return
+    /// the second operand for NaN so the running interval is kept.
+    __m128 slabSSE(const __m128 (&o)[3], const __m128 (&inv)[3], const __m128 (&lo)[3], const __m128 (&hi)[3])
+    {
+        auto tNear = _mm_set1_ps(-INFINITY);
+        auto tFar = _mm_set1_ps(INFINITY);
+        for (int k = 0; k < 3; ++k)
+        {
+            const auto t1 = _mm_mul_ps(_mm_sub_ps(lo[k], o[k]), inv[k]);
+            const auto t2 = _mm_mul_ps(_mm_sub_ps(hi[k], o[k]), inv[k]);
+            const auto nan = _mm_cmpunord_ps(t1, t2);
+            tNear = _mm_max_ps(_mm_or_ps(_mm_min_ps(t1, t2), nan), tNear);
+            tFar = _mm_min_ps(_mm_or_ps(_mm_max_ps(t1, t2), nan), tFar);
+        }
+        const auto zero = _mm_setzero_ps();
+        const auto hit = _mm_cmpge_ps(tFar, _mm_max_ps(tNear, zero));
+        const auto front = _mm_cmpge_ps(tNear, zero);
+        const auto d = _mm_or_ps(_mm_and_ps(front, tNear), _mm_andnot_ps(front, tFar));
+        return _mm_or_ps(_mm_and_ps(hit, d), _mm_andnot_ps(hit, _mm_set1_ps(-INFINITY)));
+    }
+
+    GF_TARGET("avx") __m256 slabAVX(const __m256 (&o)[3], const __m256 (&inv)[3], const __m256 (&lo)[3], const __m256 (&hi)[3])
+    {
+        auto tNear = _mm256_set1_ps(-INFINITY);
+        auto tFar = _mm256_set1_ps(INFINITY);
+        for (int k = 0; k < 3; ++k)
+        {
+            const auto t1 = _mm256_mul_ps(_mm256_sub_ps(lo[k], o[k]), inv[k]);
+            const auto t2 = _mm256_mul_ps(_mm256_sub_ps(hi[k], o[k]), inv[k]);
+            const auto nan = _mm256_cmp_ps(t1, t2, _CMP_UNORD_Q);
+            tNear = _mm256_max_ps(_mm256_or_ps(_mm256_min_ps(t1, t2), nan), tNear);
+            tFar = _mm256_min_ps(_mm256_or_ps(_mm256_max_ps(t1, t2), nan), tFar);
+        }
+        const auto zero = _mm256_setzero_ps();
+        const auto hit = _mm256_cmp_ps(tFar, _mm256_max_ps(tNear, zero), _CMP_GE_OQ);
+        return _mm256_blendv_ps(_mm256_set1_ps(-INFINITY),
+            _mm256_blendv_ps(tFar, tNear, _mm256_cmp_ps(tNear, zero, _CMP_GE_OQ)), hit);
+    }
+
+    /// Return the first index not processed
+    size_t intersectRaysSSE(const AxisAlignedBox& box, const RayArrays& rays, size_t n, float* distances)
+    {
+        const __m128 lo[3] = { _mm_set1_ps(box.minimum.x), _mm_set1_ps(box.minimum.y), _mm_set1_ps(box.minimum.z) };
+        const __m128 hi[3] = { _mm_set1_ps(box.maximum.x), _mm_set1_ps(box.maximum.y), _mm_set1_ps(box.maximum.z) };
+        const auto one = _mm_set1_ps(1);
+
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128 o[3] = { _mm_loadu_ps(rays.originX + i), _mm_loadu_ps(rays.originY + i), _mm_loadu_ps(rays.originZ + i) };
+            const __m128 inv[3] = {
+                _mm_div_ps(one, _mm_loadu_ps(rays.dirX + i)),
+                _mm_div_ps(one, _mm_loadu_ps(rays.dirY + i)),
+                _mm_div_ps(one, _mm_loadu_ps(rays.dirZ + i))
+            };
+            _mm_storeu_ps(distances + i, slabSSE(o, inv, lo, hi));
+        }
+        return i;
+    }
+
+    GF_TARGET("avx") size_t intersectRaysAVX(const AxisAlignedBox& box, const RayArrays& rays, size_t n, float* distances)
+    {
+        const __m256 lo[3] = { _mm256_set1_ps(box.minimum.x), _mm256_set1_ps(box.minimum.y), _mm256_set1_ps(box.minimum.z) };
+        const __m256 hi[3] = { _mm256_set1_ps(box.maximum.x), _mm256_set1_ps(box.maximum.y), _mm256_set1_ps(box.maximum.z) };
+        const auto one = _mm256_set1_ps(1);
+
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256 o[3] = { _mm256_loadu_ps(rays.originX + i), _mm256_loadu_ps(rays.originY + i), _mm256_loadu_ps(rays.originZ + i) };
+            const __m256 inv[3] = {
+                _mm256_div_ps(one, _mm256_loadu_ps(rays.dirX + i)),
+                _mm256_div_ps(one, _mm256_loadu_ps(rays.dirY + i)),
+                _mm256_div_ps(one, _mm256_loadu_ps(rays.dirZ + i))
+            };
+            _mm256_storeu_ps(distances + i, slabAVX(o, inv, lo, hi));
+        }
+        _mm256_zeroupper();
+        return i;
+    }
+
+    size_t intersectBoxesSSE(const float (&origin)[3], const float (&inv)[3], const AxisAlignedBoxArrays& boxes, size_t n, float* distances)
+    {
+        const __m128 o[3] = { _mm_set1_ps(origin[0]), _mm_set1_ps(origin[1]), _mm_set1_ps(origin[2]) };
+        const __m128 vinv[3] = { _mm_set1_ps(inv[0]), _mm_set1_ps(inv[1]), _mm_set1_ps(inv[2]) };
+
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128 lo[3] = { _mm_loadu_ps(boxes.minX + i), _mm_loadu_ps(boxes.minY + i), _mm_loadu_ps(boxes.minZ + i) };
+            const __m128 hi[3] = { _mm_loadu_ps(boxes.maxX + i), _mm_loadu_ps(boxes.maxY + i), _mm_loadu_ps(boxes.maxZ + i) };
+            _mm_storeu_ps(distances + i, slabSSE(o, vinv, lo, hi));
+        }
+        return i;
+    }
+
+    GF_TARGET("avx") size_t intersectBoxesAVX(const float (&origin)[3], const float (&inv)[3], const AxisAlignedBoxArrays& boxes, size_t n, float* distances)
+    {
+        const __m256 o[3] = { _mm256_set1_ps(origin[0]), _mm256_set1_ps(origin[1]), _mm256_set1_ps(origin[2]) };
+        const __m256 vinv[3] = { _mm256_set1_ps(inv[0]), _mm256_set1_ps(inv[1]), _mm256_set1_ps(inv[2]) };
+
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256 lo[3] = { _mm256_loadu_ps(boxes.minX + i), _mm256_loadu_ps(boxes.minY + i), _mm256_loadu_ps(boxes.minZ + i) };
+            const __m256 hi[3] = { _mm256_loadu_ps(boxes.maxX + i), _mm256_loadu_ps(boxes.maxY + i), _mm256_loadu_ps(boxes.maxZ + i) };
+            _mm256_storeu_ps(distances + i, slabAVX(o, vinv, lo, hi));
+        }
+        _mm256_zeroupper();
+        return i;
+    }
+#endif
+}
+
 const AxisAlignedBox AxisAlignedBox::NEGATIVE = { { FLT_MAX,  FLT_MAX,  FLT_MAX }, { -FLT_MAX,  -FLT_MAX,  -FLT_MAX } };
 
 AxisAlignedBox::AxisAlignedBox(const Vector3& min, const Vector3& max)
@@ -32,12 +179,17 @@ Vector3 AxisAlignedBox::centroid() const
 
 AxisAlignedBox AxisAlignedBox::transform(const Matrix44& m) const
 {
+    Vector3 corners[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        corners[i] = corner(i);
+    }
+    projectPoints(m, corners, corners, 8);
+
     auto result = AxisAlignedBox::NEGATIVE;
     for (int i = 0; i < 8; ++i)
     {
-        const auto v = corner(i).xyzw(1) * m;
-        check(!equalf(v.w, 0)); /// TODO: Infinite AABB ?
-        result.merge(v.xyz() / v.w);
+        result.merge(corners[i]);
     }
     return result;
 }
@@ -72,41 +224,54 @@ bool AxisAlignedBox::contains(const AxisAlignedBox& box) const
 
 float AxisAlignedBox::intersects(const Vector3& origin, const Vector3& dir) const
 {
-    const std::array<Plane, 6> sides = {
-        Plane(Vector3::UNIT_X, -minimum.x),
-        Plane(-Vector3::UNIT_X, maximum.x),
-        Plane(Vector3::UNIT_Y, -minimum.y),
-        Plane(-Vector3::UNIT_Y, maximum.y),
-        Plane(Vector3::UNIT_Z, -minimum.z),
-        Plane(-Vector3::UNIT_Z, maximum.z)
-    };
-
-    for (int i = 0; i < 6; ++i)
-    {
-        const auto d = sides[i].intersects(origin, dir);
-        if (d + EPSILON < 0)
-        {
-            continue;
-        }
+    const float o[3] = { origin.x, origin.y, origin.z };
+    const float inv[3] = { 1 / dir.x, 1 / dir.y, 1 / dir.z };
+    const float lo[3] = { minimum.x, minimum.y, minimum.z };
+    const float hi[3] = { maximum.x, maximum.y, maximum.z };
+    return slab(o, inv, lo, hi);
+}
 
-        const auto hitAt = origin + dir * d;
-        bool inside = true;
-        for (int j = 0; j < 6 && inside; ++j)
-        {
-            if (j == i)
-            {
-                continue;
-            }
-            inside = sides[j].dotCoord(hitAt) + EPSILON >= 0;
-        }
+void intersectRays(const AxisAlignedBox& box, const RayArrays& rays, size_t n, float* distances)
+{
+    check(distances);
 
-        if (inside)
-        {
-            return d;
-        }
+    size_t done = 0;
+#ifdef GF_SSE
+    done = cpuFeatures().avx ?
+        intersectRaysAVX(box, rays, n, distances) :
+        intersectRaysSSE(box, rays, n, distances);
+#endif
+
+    const float lo[3] = { box.minimum.x, box.minimum.y, box.minimum.z };
+    const float hi[3] = { box.maximum.x, box.maximum.y, box.maximum.z };
+    for (size_t i = done; i < n; ++i)
+    {
+        const float o[3] = { rays.originX[i], rays.originY[i], rays.originZ[i] };
+        const float inv[3] = { 1 / rays.dirX[i], 1 / rays.dirY[i], 1 / rays.dirZ[i] };
+        distances[i] = slab(o, inv, lo, hi);
     }
+}
+
+void intersectBoxes(const Vector3& origin, const Vector3& dir, const AxisAlignedBoxArrays& boxes, size_t n, float* distances)
+{
+    check(distances);
 
-    return -INFINITY;
+    const float o[3] = { origin.x, origin.y, origin.z };
+    const float inv[3] = { 1 / dir.x, 1 / dir.y, 1 / dir.z };
+
+    size_t done = 0;
+#ifdef GF_SSE
+    done = cpuFeatures().avx ?
+        intersectBoxesAVX(o, inv, boxes, n, distances) :
+        intersectBoxesSSE(o, inv, boxes, n, distances);
+#endif
+
+    for (size_t i = done; i < n; ++i)
+    {
+        const float lo[3] = { boxes.minX[i], boxes.minY[i], boxes.minZ[i] };
+        const float hi[3] = { boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i] };
+        distances[i] = slab(o, inv, lo, hi);
+    }
 }
 
 GF_NAMESPACE_END
\ No newline at end of file
@@ -39,6 +39,37 @@ struct AxisAlignedBox
     static const AxisAlignedBox NEGATIVE;
 };
 
+/// Boxes as structure of arrays
+struct AxisAlignedBoxArrays
+{
+    const float* minX;
+    const float* minY;
+    const float* minZ;
+    const float* maxX;
+    const float* maxY;
+    const float* maxZ;
+};
+
+/// Rays as structure of arrays. Directions need not be unit length.
+struct RayArrays
+{
+    const float* originX;
+    const float* originY;
+    const float* originZ;
+    const float* dirX;
+    const float* dirY;
+    const float* dirZ;
+};
+
+/// Packet slab tests. distances[i] is measured in units of the direction,
+/// at the entry point or at the exit point when the origin is inside,
+/// and -INFINITY on a miss like AxisAlignedBox::intersects.
+/// Rays are processed 8 or 4 per step depending on the CPU.
+void intersectRays(const AxisAlignedBox& box, const RayArrays& rays, size_t n, float* distances);
+
+/// One ray against n boxes
+void intersectBoxes(const Vector3& origin, const Vector3& dir, const AxisAlignedBoxArrays& boxes, size_t n, float* distances);
+
 GF_NAMESPACE_END
 
 #endif
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "batchtransform.h"
+#include "matrix44.h"
+#include "vector3.h"
+#include "math.h"
+#include "exception.h"
+
+#ifdef GF_SSE
+    #include <xmmintrin.h>
+#endif
+
+GF_NAMESPACE_BEGIN
+
+namespace
+{
+    enum class Mode
+    {
+        point,
+        direction,
+        project
+    };
+
+    template <Mode M>
+    void transform1(const float* m, float x, float y, float z, float& ox, float& oy, float& oz)
+    {
+        auto tx = x * m[0] + y * m[4] + z * m[8];
+        auto ty = x * m[1] + y * m[5] + z * m[9];
+        auto tz = x * m[2] + y * m[6] + z * m[10];
+
+        if (M != Mode::direction)
+        {
+            tx += m[12];
+            ty += m[13];
+            tz += m[14];
+        }
+
+        if (M == Mode::project)
+        {
+            const auto w = x * m[3] + y * m[7] + z * m[11] + m[15];
+            check(!equalf(w, 0)); /// TODO: Infinite AABB ?
+            const auto invW = 1 / w;
+            tx *= invW;
+            ty *= invW;
+            tz *= invW;
+        }
+
+        ox = tx;
+        oy = ty;
+        oz = tz;
+    }
+
+#ifdef GF_SSE
+    #define GF_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+
+    struct Broadcast
+    {
+        __m128 e[16];
+
+        explicit Broadcast(const float* m)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                e[i] = _mm_set1_ps(m[i]);
+            }
+        }
+    };
+
+    /// Same operation order as transform1
+    template <Mode M>
+    void transform4(const Broadcast& m, __m128 x, __m128 y, __m128 z, __m128& ox, __m128& oy, __m128& oz)
+    {
+        auto tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.e[0]), _mm_mul_ps(y, m.e[4])), _mm_mul_ps(z, m.e[8]));
+        auto ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.e[1]), _mm_mul_ps(y, m.e[5])), _mm_mul_ps(z, m.e[9]));
+        auto tz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.e[2]), _mm_mul_ps(y, m.e[6])), _mm_mul_ps(z, m.e[10]));
+
+        if (M != Mode::direction)
+        {
+            tx = _mm_add_ps(tx, m.e[12]);
+            ty = _mm_add_ps(ty, m.e[13]);
+            tz = _mm_add_ps(tz, m.e[14]);
+        }
+
+        if (M == Mode::project)
+        {
+            const auto w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.e[3]), _mm_mul_ps(y, m.e[7])), _mm_mul_ps(z, m.e[11])), m.e[15]);
+            // Same as the !equalf(w, 0) check of transform1, lane by lane
+            check(_mm_movemask_ps(_mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), w), _mm_set1_ps(EPSILON))) == 0);
+            const auto invW = _mm_div_ps(_mm_set1_ps(1), w);
+            tx = _mm_mul_ps(tx, invW);
+            ty = _mm_mul_ps(ty, invW);
+            tz = _mm_mul_ps(tz, invW);
+        }
+
+        ox = tx;
+        oy = ty;
+        oz = tz;
+    }
+
+    /// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 -> xxxx yyyy zzzz
+    void deinterleave(__m128 v0, __m128 v1, __m128 v2, __m128& x, __m128& y, __m128& z)
+    {
+        x = GF_SHUFFLE(GF_SHUFFLE(v0, v0, 0, 0, 3, 3), GF_SHUFFLE(v1, v2, 2, 2, 1, 1), 0, 2, 0, 2);
+        y = GF_SHUFFLE(GF_SHUFFLE(v0, v1, 1, 1, 0, 0), GF_SHUFFLE(v1, v2, 3, 3, 2, 2), 0, 2, 0, 2);
+        z = GF_SHUFFLE(GF_SHUFFLE(v0, v1, 2, 2, 1, 1), GF_SHUFFLE(v2, v2, 0, 0, 3, 3), 0, 2, 0, 2);
+    }
+
+    /// xxxx yyyy zzzz -> x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+    void interleave(__m128 x, __m128 y, __m128 z, __m128& v0, __m128& v1, __m128& v2)
+    {
+        v0 = GF_SHUFFLE(GF_SHUFFLE(x, y, 0, 0, 0, 0), GF_SHUFFLE(z, x, 0, 0, 1, 1), 0, 2, 0, 2);
+        v1 = GF_SHUFFLE(GF_SHUFFLE(y, z, 1, 1, 1, 1), GF_SHUFFLE(x, y, 2, 2, 2, 2), 0, 2, 0, 2);
+        v2 = GF_SHUFFLE(GF_SHUFFLE(z, x, 2, 2, 3, 3), GF_SHUFFLE(y, z, 3, 3, 3, 3), 0, 2, 0, 2);
+    }
+
+    #undef GF_SHUFFLE
+#endif
+
+    template <Mode M>
+    void transformSoA(const Matrix44& m, const float* inX, const float* inY, const float* inZ,
+        float* outX, float* outY, float* outZ, size_t n)
+    {
+        const auto p = m.data();
+        size_t i = 0;
+
+#ifdef GF_SSE
+        const Broadcast b(p);
+        for (; i + 4 <= n; i += 4)
+        {
+            __m128 x, y, z;
+            transform4<M>(b, _mm_loadu_ps(inX + i), _mm_loadu_ps(inY + i), _mm_loadu_ps(inZ + i), x, y, z);
+            _mm_storeu_ps(outX + i, x);
+            _mm_storeu_ps(outY + i, y);
+            _mm_storeu_ps(outZ + i, z);
+        }
+#endif
+
+        for (; i < n; ++i)
+        {
+            transform1<M>(p, inX[i], inY[i], inZ[i], outX[i], outY[i], outZ[i]);
+        }
+    }
+
+    template <Mode M>
+    void transformAoS(const Matrix44& m, const Vector3* in, Vector3* out, size_t n)
+    {
+        const auto p = m.data();
+        size_t i = 0;
+
+#ifdef GF_SSE
+        const Broadcast b(p);
+        for (; i + 4 <= n; i += 4)
+        {
+            const auto src = &in[i].x;
+            const auto dest = &out[i].x;
+
+            __m128 x, y, z;
+            deinterleave(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+            transform4<M>(b, x, y, z, x, y, z);
+
+            __m128 v0, v1, v2;
+            interleave(x, y, z, v0, v1, v2);
+            _mm_storeu_ps(dest, v0);
+            _mm_storeu_ps(dest + 4, v1);
+            _mm_storeu_ps(dest + 8, v2);
+        }
+#endif
+
+        for (; i < n; ++i)
+        {
+            transform1<M>(p, in[i].x, in[i].y, in[i].z, out[i].x, out[i].y, out[i].z);
+        }
+    }
+}
+
+void transformPoints(const Matrix44& m, const Vector3* in, Vector3* out, size_t n)
+{
+    static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be tightly packed.");
+    transformAoS<Mode::point>(m, in, out, n);
+}
+
+void transformPoints(const Matrix44& m, const float* inX, const float* inY, const float* inZ,
+    float* outX, float* outY, float* outZ, size_t n)
+{
+    transformSoA<Mode::point>(m, inX, inY, inZ, outX, outY, outZ, n);
+}
+
+void transformDirections(const Matrix44& m, const Vector3* in, Vector3* out, size_t n)
+{
+    transformAoS<Mode::direction>(m, in, out, n);
+}
+
+void transformDirections(const Matrix44& m, const float* inX, const float* inY, const float* inZ,
+    float* outX, float* outY, float* outZ, size_t n)
+{
+    transformSoA<Mode::direction>(m, inX, inY, inZ, outX, outY, outZ, n);
+}
+
+void projectPoints(const Matrix44& m, const Vector3* in, Vector3* out, size_t n)
+{
+    transformAoS<Mode::project>(m, in, out, n);
+}
+
+void projectPoints(const Matrix44& m, const float* inX, const float* inY, const float* inZ,
+    float* outX, float* outY, float* outZ, size_t n)
+{
+    transformSoA<Mode::project>(m, inX, inY, inZ, outX, outY, outZ, n);
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
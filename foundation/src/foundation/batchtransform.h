@@ -0,0 +1,32 @@
+#ifndef GAMEFRIENDS_BATCHTRANSFORM_H
+#define GAMEFRIENDS_BATCHTRANSFORM_H
+
+#include "prerequest.h"
+#include <cstddef>
+
+GF_NAMESPACE_BEGIN
+
+class Vector3;
+class Matrix44;
+
+/// Batch transforms by row vector convention (v * m), 4 elements per SIMD step.
+/// in == out is allowed. Partially overlapping ranges are not.
+
+/// (p, 1) * m. The 4th column of m is ignored.
+void transformPoints(const Matrix44& m, const Vector3* in, Vector3* out, size_t n);
+void transformPoints(const Matrix44& m, const float* inX, const float* inY, const float* inZ,
+    float* outX, float* outY, float* outZ, size_t n);
+
+/// (d, 0) * m. Translation and the 4th column of m are ignored.
+void transformDirections(const Matrix44& m, const Vector3* in, Vector3* out, size_t n);
+void transformDirections(const Matrix44& m, const float* inX, const float* inY, const float* inZ,
+    float* outX, float* outY, float* outZ, size_t n);
+
+/// (p, 1) * m followed by the divide by w.
+void projectPoints(const Matrix44& m, const Vector3* in, Vector3* out, size_t n);
+void projectPoints(const Matrix44& m, const float* inX, const float* inY, const float* inZ,
+    float* outX, float* outY, float* outZ, size_t n);
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef GAMEFRIENDS_COLOR_H
 #define GAMEFRIENDS_COLOR_H
 
+#include "exception.h"
 #include "prerequest.h"
 
 GF_NAMESPACE_BEGIN
@@ -9,8 +10,8 @@ struct Color
 {
     float r, g, b, a;
 
-    Color();
-    Color(float r_, float g_, float b_, float a_);
+    constexpr Color();
+    constexpr Color(float r_, float g_, float b_, float a_);
     Color(const Color&) = default;
 
     Color& operator =(const Color&) = default;
@@ -25,6 +26,39 @@ struct Color
     static const Color BLACK;
 };
 
+/// Same as BLACK
+constexpr Color::Color()
+    : Color(0, 0, 0, 1)
+{
+}
+
+constexpr Color::Color(float r_, float g_, float b_, float a_)
+    : r(r_)
+    , g(g_)
+    , b(b_)
+    , a(a_)
+{
+}
+
+inline const float& Color::operator [](size_t i) const
+{
+    return const_cast<Color&>(*this)[i];
+}
+
+inline float& Color::operator [](size_t i)
+{
+    switch (i)
+    {
+    case 0: return r;
+    case 1: return g;
+    case 2: return b;
+    case 3: return a;
+    default:
+        check(false);
+        return r;
+    }
+}
+
 GF_NAMESPACE_END
 
 #endif
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "cpu.h"
+
+#ifdef GF_SSE
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+GF_NAMESPACE_BEGIN
+
+namespace
+{
+#ifdef GF_SSE
+    void cpuid(int leaf, int subleaf, unsigned (&regs)[4])
+    {
+#ifdef _MSC_VER
+        int r[4];
+        __cpuidex(r, leaf, subleaf);
+        for (int i = 0; i < 4; ++i)
+        {
+            regs[i] = static_cast<unsigned>(r[i]);
+        }
+#else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    uint64 xgetbv0()
+    {
+#ifdef _MSC_VER
+        return _xgetbv(0);
+#else
+        unsigned lo, hi;
+        __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return (static_cast<uint64>(hi) << 32) | lo;
+#endif
+    }
+#endif
+
+    CpuFeatures detect()
+    {
+        CpuFeatures f = {};
+
+#ifdef GF_SSE
+        unsigned regs[4];
+        cpuid(0, 0, regs);
+        const auto maxLeaf = regs[0];
+        if (maxLeaf < 1)
+        {
+            return f;
+        }
+
+        cpuid(1, 0, regs);
+        const auto ecx1 = regs[2];
+        const auto edx1 = regs[3];
+
+        f.sse2 = !!(edx1 & (1 << 26));
+        f.sse3 = !!(ecx1 & (1 << 0));
+        f.sse41 = !!(ecx1 & (1 << 19));
+        f.sse42 = !!(ecx1 & (1 << 20));
+
+        const bool osxsave = !!(ecx1 & (1 << 27));
+        const bool ymmSaved = osxsave && (xgetbv0() & 0x6) == 0x6;
+
+        f.avx = ymmSaved && !!(ecx1 & (1 << 28));
+        f.fma = f.avx && !!(ecx1 & (1 << 12));
+
+        if (maxLeaf >= 7)
+        {
+            cpuid(7, 0, regs);
+            f.avx2 = f.avx && !!(regs[1] & (1 << 5));
+        }
+#endif
+
+        return f;
+    }
+}
+
+const CpuFeatures& cpuFeatures() noexcept
+{
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
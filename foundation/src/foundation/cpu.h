@@ -0,0 +1,31 @@
+#ifndef GAMEFRIENDS_CPU_H
+#define GAMEFRIENDS_CPU_H
+
+#include "prerequest.h"
+
+/// Lets a single function use an instruction set above the compile flags (MSVC needs nothing).
+#if defined(GF_SSE) && defined(__GNUC__)
+    #define GF_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define GF_TARGET(isa)
+#endif
+
+GF_NAMESPACE_BEGIN
+
+struct CpuFeatures
+{
+    bool sse2;
+    bool sse3;
+    bool sse41;
+    bool sse42;
+    bool avx;
+    bool avx2;
+    bool fma;
+};
+
+/// Detected once at the first call. AVX bits are cleared when the OS does not save YMM registers.
+const CpuFeatures& cpuFeatures() noexcept;
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
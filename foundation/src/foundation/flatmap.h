@@ -0,0 +1,174 @@
+#ifndef GAMEFRIENDS_FLATMAP_H
+#define GAMEFRIENDS_FLATMAP_H
+
+#include "sortedvector.h"
+#include "exception.h"
+#include "prerequest.h"
+#include <initializer_list>
+#include <utility>
+
+GF_NAMESPACE_BEGIN
+
+/// Unique sorted map on a SortedVector of key-value pairs.
+/// Keys must not be changed through iterators.
+template <class K, class V, class Comp = std::less<K>, class Alloc = std::allocator<std::pair<K, V>>>
+class FlatMap
+{
+public:
+    using ValueType = std::pair<K, V>;
+
+    class KeyComp
+    {
+    private:
+        Comp comp_;
+
+    public:
+        explicit KeyComp(const Comp& comp = Comp())
+            : comp_(comp)
+        {
+        }
+
+        bool operator ()(const ValueType& a, const ValueType& b) const { return comp_(a.first, b.first); }
+        bool operator ()(const ValueType& a, const K& b) const { return comp_(a.first, b); }
+        bool operator ()(const K& a, const ValueType& b) const { return comp_(a, b.first); }
+
+        Comp keyComp() const { return comp_; }
+    };
+
+    using StorageType = SortedVector<ValueType, KeyComp, Alloc>;
+    using Iterator = typename StorageType::Iterator;
+    using CIterator = typename StorageType::CIterator;
+    using RIterator = typename StorageType::RIterator;
+    using CRIterator = typename StorageType::CRIterator;
+
+private:
+    StorageType vec_;
+
+public:
+    explicit FlatMap(const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : vec_(KeyComp(comp), alloc)
+    {
+    }
+
+    template <class InputIterator>
+    FlatMap(InputIterator first, InputIterator last, const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : vec_(KeyComp(comp), alloc)
+    {
+        insert(first, last);
+    }
+
+    FlatMap(std::initializer_list<ValueType> il, const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : vec_(KeyComp(comp), alloc)
+    {
+        insert(il);
+    }
+
+    Iterator begin()    noexcept { return vec_.begin(); }
+    Iterator end()      noexcept { return vec_.end(); }
+    CIterator begin()   const noexcept { return vec_.begin(); }
+    CIterator end()     const noexcept { return vec_.end(); }
+
+    RIterator rbegin()  noexcept { return vec_.rbegin(); }
+    RIterator rend()    noexcept { return vec_.rend(); }
+    CRIterator rbegin() const noexcept { return vec_.rbegin(); }
+    CRIterator rend()   const noexcept { return vec_.rend(); }
+
+    CIterator cbegin()  const noexcept { return vec_.cbegin(); }
+    CIterator cend()    const noexcept { return vec_.cend(); }
+
+    size_t size()       const noexcept { return vec_.size(); }
+    size_t capacity()   const noexcept { return vec_.capacity(); }
+    bool empty()        const noexcept { return vec_.empty(); }
+    void reserve(size_t n)  { vec_.reserve(n); }
+    void shrink()           { vec_.shrink(); }
+
+    std::pair<Iterator, bool> insert(const ValueType& val)  { return vec_.insertUnique(val); }
+    std::pair<Iterator, bool> insert(ValueType&& val)       { return vec_.insertUnique(std::move(val)); }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) { vec_.insertUnique(first, last); }
+
+    void insert(std::initializer_list<ValueType> il) { vec_.insertUnique(std::cbegin(il), std::cend(il)); }
+
+    /// Constructs the value only if key is not present
+    template <class... Args>
+    std::pair<Iterator, bool> emplace(const K& key, Args&&... args)
+    {
+        const auto it = vec_.lowerBound(key);
+        if (it != std::end(vec_) && !vec_.comp()(key, *it))
+        {
+            return{ it, false };
+        }
+        return{ vec_.insert(it, ValueType(key, V(std::forward<Args>(args)...))), true };
+    }
+
+    /// Overwrites the value if key is present
+    template <class M>
+    std::pair<Iterator, bool> assign(const K& key, M&& val)
+    {
+        const auto it = vec_.lowerBound(key);
+        if (it != std::end(vec_) && !vec_.comp()(key, *it))
+        {
+            it->second = std::forward<M>(val);
+            return{ it, false };
+        }
+        return{ vec_.insert(it, ValueType(key, std::forward<M>(val))), true };
+    }
+
+    V& operator[](const K& key) { return emplace(key).first->second; }
+
+    V& at(const K& key)
+    {
+        const auto it = find(key);
+        check(it != end());
+        return it->second;
+    }
+
+    const V& at(const K& key) const
+    {
+        const auto it = find(key);
+        check(it != end());
+        return it->second;
+    }
+
+    Iterator find(const K& key)             { return vec_.find(key); }
+    CIterator find(const K& key)            const { return vec_.find(key); }
+    bool contains(const K& key)             const { return vec_.contains(key); }
+    Iterator lowerBound(const K& key)       { return vec_.lowerBound(key); }
+    CIterator lowerBound(const K& key)      const { return vec_.lowerBound(key); }
+    Iterator upperBound(const K& key)       { return vec_.upperBound(key); }
+    CIterator upperBound(const K& key)      const { return vec_.upperBound(key); }
+
+    Iterator erase(CIterator pos)                   { return vec_.erase(pos); }
+    Iterator erase(CIterator first, CIterator last) { return vec_.erase(first, last); }
+
+    size_t erase(const K& key)
+    {
+        const auto it = vec_.find(key);
+        if (it == std::end(vec_))
+        {
+            return 0;
+        }
+        vec_.erase(it);
+        return 1;
+    }
+
+    void swap(FlatMap& x) { vec_.swap(x.vec_); }
+    void clear() noexcept { vec_.clear(); }
+
+    Comp comp() const { return vec_.comp().keyComp(); }
+    Alloc allocator() const noexcept { return vec_.allocator(); }
+};
+
+GF_NAMESPACE_END
+
+namespace std
+{
+    template <class K, class V, class C, class A>
+    void swap(GF_NAMESPACE::FlatMap<K, V, C, A>& a, GF_NAMESPACE::FlatMap<K, V, C, A>& b)
+    {
+        a.swap(b);
+    }
+}
+
+#endif
\ No newline at end of file
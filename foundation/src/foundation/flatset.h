@@ -0,0 +1,102 @@
+#ifndef GAMEFRIENDS_FLATSET_H
+#define GAMEFRIENDS_FLATSET_H
+
+#include "sortedvector.h"
+#include "prerequest.h"
+#include <initializer_list>
+#include <utility>
+
+GF_NAMESPACE_BEGIN
+
+/// Unique sorted set on a SortedVector. Elements are immutable through iterators.
+template <class T, class Comp = std::less<T>, class Alloc = std::allocator<T>>
+class FlatSet
+{
+public:
+    using StorageType = SortedVector<T, Comp, Alloc>;
+    using Iterator = typename StorageType::CIterator;
+    using CIterator = typename StorageType::CIterator;
+    using RIterator = typename StorageType::CRIterator;
+    using CRIterator = typename StorageType::CRIterator;
+
+private:
+    StorageType vec_;
+
+public:
+    explicit FlatSet(const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : vec_(comp, alloc)
+    {
+    }
+
+    template <class InputIterator>
+    FlatSet(InputIterator first, InputIterator last, const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : vec_(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    FlatSet(std::initializer_list<T> il, const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : vec_(comp, alloc)
+    {
+        insert(il);
+    }
+
+    CIterator begin()   const noexcept { return vec_.cbegin(); }
+    CIterator end()     const noexcept { return vec_.cend(); }
+    CRIterator rbegin() const noexcept { return vec_.crbegin(); }
+    CRIterator rend()   const noexcept { return vec_.crend(); }
+    CIterator cbegin()  const noexcept { return vec_.cbegin(); }
+    CIterator cend()    const noexcept { return vec_.cend(); }
+
+    size_t size()       const noexcept { return vec_.size(); }
+    size_t capacity()   const noexcept { return vec_.capacity(); }
+    bool empty()        const noexcept { return vec_.empty(); }
+    void reserve(size_t n)  { vec_.reserve(n); }
+    void shrink()           { vec_.shrink(); }
+
+    const T& operator[](size_t n) const { return vec_[n]; }
+    const T* data() const noexcept { return vec_.data(); }
+
+    std::pair<CIterator, bool> insert(const T& val) { return vec_.insertUnique(val); }
+    std::pair<CIterator, bool> insert(T&& val)      { return vec_.insertUnique(std::move(val)); }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) { vec_.insertUnique(first, last); }
+
+    void insert(std::initializer_list<T> il) { vec_.insertUnique(std::cbegin(il), std::cend(il)); }
+
+    template <class... Args>
+    std::pair<CIterator, bool> emplace(Args&&... args) { return vec_.emplaceUnique(std::forward<Args>(args)...); }
+
+    template <class Key>
+    CIterator find(const Key& key) const { return vec_.find(key); }
+    template <class Key>
+    bool contains(const Key& key) const { return vec_.contains(key); }
+    template <class Key>
+    CIterator lowerBound(const Key& key) const { return vec_.lowerBound(key); }
+    template <class Key>
+    CIterator upperBound(const Key& key) const { return vec_.upperBound(key); }
+
+    CIterator erase(CIterator pos)                      { return vec_.erase(pos); }
+    CIterator erase(CIterator first, CIterator last)    { return vec_.erase(first, last); }
+    size_t erase(const T& val)                          { return vec_.erase(val); }
+
+    void swap(FlatSet& x) { vec_.swap(x.vec_); }
+    void clear() noexcept { vec_.clear(); }
+
+    Comp comp() const { return vec_.comp(); }
+    Alloc allocator() const noexcept { return vec_.allocator(); }
+};
+
+GF_NAMESPACE_END
+
+namespace std
+{
+    template <class T, class C, class A>
+    void swap(GF_NAMESPACE::FlatSet<T, C, A>& a, GF_NAMESPACE::FlatSet<T, C, A>& b)
+    {
+        a.swap(b);
+    }
+}
+
+#endif
\ No newline at end of file
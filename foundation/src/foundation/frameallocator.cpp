@@ -0,0 +1,60 @@
+#include "frameallocator.h"
+#include <algorithm>
+
+GF_NAMESPACE_BEGIN
+
+FrameAllocator::FrameAllocator(size_t blockSize)
+    : front_(blockSize)
+    , back_(blockSize)
+    , current_(&front_)
+    , frame_(0)
+    , highWater_(0)
+{
+}
+
+void* FrameAllocator::allocate(size_t size, size_t alignment)
+{
+    return current_->allocate(size, alignment);
+}
+
+void FrameAllocator::deallocate(void* p, size_t size) noexcept
+{
+    // Reclaimed by nextFrame(), which also poisons. Poisoning here could hit a stale pointer into reused memory.
+    (void)p;
+    (void)size;
+}
+
+void FrameAllocator::nextFrame()
+{
+    highWater_ = std::max(highWater_, current_->stats().used);
+    current_ = current_ == &front_ ? &back_ : &front_;
+    current_->reset();
+    ++frame_;
+}
+
+uint64 FrameAllocator::frame() const
+{
+    return frame_;
+}
+
+void FrameAllocator::release()
+{
+    front_.release();
+    back_.release();
+}
+
+AllocatorStats FrameAllocator::stats() const
+{
+    const auto f = front_.stats();
+    const auto b = back_.stats();
+    const auto c = current_->stats();
+
+    AllocatorStats stats = {};
+    stats.used = c.used;
+    stats.highWater = std::max(highWater_, c.used);
+    stats.capacity = f.capacity + b.capacity;
+    stats.allocations = f.allocations + b.allocations;
+    return stats;
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef GAMEFRIENDS_FRAMEALLOCATOR_H
+#define GAMEFRIENDS_FRAMEALLOCATOR_H
+
+#include "arenaallocator.h"
+#include "allocator.h"
+#include "prerequest.h"
+
+GF_NAMESPACE_BEGIN
+
+/// Double buffered per-frame allocator.
+/// Memory allocated during a frame stays valid until the end of the next frame, so it can be consumed one frame late.
+/// Containers must not outlive that either; MSVC debug builds allocate iterator proxies through the allocator.
+class FrameAllocator
+{
+private:
+    ArenaAllocator front_;
+    ArenaAllocator back_;
+    ArenaAllocator* current_;
+    uint64 frame_;
+    size_t highWater_;
+
+public:
+    explicit FrameAllocator(size_t blockSize = ArenaAllocator::DEFAULT_BLOCK_SIZE);
+
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator =(const FrameAllocator&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept(false);
+    void deallocate(void* p, size_t size) noexcept;
+
+    /// Switches to the other buffer and resets it. Invalidates memory allocated two frames ago.
+    void nextFrame();
+    uint64 frame() const;
+
+    void release();
+
+    /// used is for the current frame; highWater is the peak over any single frame
+    AllocatorStats stats() const;
+};
+
+template <class T>
+using FrameStdAllocator = StdAllocator<T, FrameAllocator>;
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
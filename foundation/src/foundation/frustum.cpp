@@ -1,9 +1,147 @@
 #include "frustum.h"
 #include "matrix44.h"
 #include "vector4.h"
+#include "cpu.h"
+#include "exception.h"
+#include <algorithm>
+
+#ifdef GF_SSE
+    #include <immintrin.h>
+#endif
 
 GF_NAMESPACE_BEGIN
 
+namespace
+{
+    /// Per plane, the p-vertex takes max on axes where the normal is non-negative
+    /// and the n-vertex takes the other side. The choice is the same for every box.
+    struct CullPlane
+    {
+        float nx, ny, nz, d;
+        const float* pX;
+        const float* pY;
+        const float* pZ;
+        const float* nX;
+        const float* nY;
+        const float* nZ;
+    };
+
+    void setupCullPlanes(const Frustum& frustum, const AxisAlignedBoxArrays& boxes, CullPlane (&out)[6])
+    {
+        for (int i = 0; i < 6; ++i)
+        {
+            const auto& plane = frustum.planes[i];
+            auto& cp = out[i];
+            cp.nx = plane.n.x;
+            cp.ny = plane.n.y;
+            cp.nz = plane.n.z;
+            cp.d = plane.d;
+            cp.pX = plane.n.x >= 0 ? boxes.maxX : boxes.minX;
+            cp.pY = plane.n.y >= 0 ? boxes.maxY : boxes.minY;
+            cp.pZ = plane.n.z >= 0 ? boxes.maxZ : boxes.minZ;
+            cp.nX = plane.n.x >= 0 ? boxes.minX : boxes.maxX;
+            cp.nY = plane.n.y >= 0 ? boxes.minY : boxes.maxY;
+            cp.nZ = plane.n.z >= 0 ? boxes.minZ : boxes.maxZ;
+        }
+    }
+
+    void setBits(uint32* mask, size_t i, uint32 bits)
+    {
+        if (mask)
+        {
+            mask[i / 32] |= bits << (i % 32);
+        }
+    }
+
+    void cullScalar(const CullPlane (&planes)[6], size_t first, size_t last, uint32* visible, uint32* intersecting)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            bool inside = true;
+            bool crossing = false;
+            for (int k = 0; k < 6 && inside; ++k)
+            {
+                const auto& p = planes[k];
+                // Written as !(< 0) so NaN distances keep the box like the cmplt of the SIMD paths
+                inside = !(p.nx * p.pX[i] + p.ny * p.pY[i] + p.nz * p.pZ[i] + p.d < 0);
+                crossing = crossing || p.nx * p.nX[i] + p.ny * p.nY[i] + p.nz * p.nZ[i] + p.d < 0;
+            }
+            setBits(visible, i, inside);
+            setBits(intersecting, i, inside && crossing);
+        }
+    }
+
+#ifdef GF_SSE
+    /// Returns the first box index not processed
+    size_t cullSSE(const CullPlane (&planes)[6], size_t n, uint32* visible, uint32* intersecting)
+    {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            auto outside = _mm_setzero_ps();
+            auto crossing = _mm_setzero_ps();
+            for (int k = 0; k < 6; ++k)
+            {
+                const auto& p = planes[k];
+                const auto nx = _mm_set1_ps(p.nx);
+                const auto ny = _mm_set1_ps(p.ny);
+                const auto nz = _mm_set1_ps(p.nz);
+                const auto d = _mm_set1_ps(p.d);
+
+                const auto pd = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(nx, _mm_loadu_ps(p.pX + i)), _mm_mul_ps(ny, _mm_loadu_ps(p.pY + i))),
+                    _mm_mul_ps(nz, _mm_loadu_ps(p.pZ + i))), d);
+                const auto nd = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(nx, _mm_loadu_ps(p.nX + i)), _mm_mul_ps(ny, _mm_loadu_ps(p.nY + i))),
+                    _mm_mul_ps(nz, _mm_loadu_ps(p.nZ + i))), d);
+
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(pd, _mm_setzero_ps()));
+                crossing = _mm_or_ps(crossing, _mm_cmplt_ps(nd, _mm_setzero_ps()));
+            }
+            const auto outsideBits = static_cast<uint32>(_mm_movemask_ps(outside));
+            const auto crossingBits = static_cast<uint32>(_mm_movemask_ps(crossing));
+            setBits(visible, i, ~outsideBits & 0xF);
+            setBits(intersecting, i, ~outsideBits & crossingBits & 0xF);
+        }
+        return i;
+    }
+
+    GF_TARGET("avx") size_t cullAVX(const CullPlane (&planes)[6], size_t n, uint32* visible, uint32* intersecting)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            auto outside = _mm256_setzero_ps();
+            auto crossing = _mm256_setzero_ps();
+            for (int k = 0; k < 6; ++k)
+            {
+                const auto& p = planes[k];
+                const auto nx = _mm256_set1_ps(p.nx);
+                const auto ny = _mm256_set1_ps(p.ny);
+                const auto nz = _mm256_set1_ps(p.nz);
+                const auto d = _mm256_set1_ps(p.d);
+
+                const auto pd = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(nx, _mm256_loadu_ps(p.pX + i)), _mm256_mul_ps(ny, _mm256_loadu_ps(p.pY + i))),
+                    _mm256_mul_ps(nz, _mm256_loadu_ps(p.pZ + i))), d);
+                const auto nd = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(nx, _mm256_loadu_ps(p.nX + i)), _mm256_mul_ps(ny, _mm256_loadu_ps(p.nY + i))),
+                    _mm256_mul_ps(nz, _mm256_loadu_ps(p.nZ + i))), d);
+
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(pd, _mm256_setzero_ps(), _CMP_LT_OQ));
+                crossing = _mm256_or_ps(crossing, _mm256_cmp_ps(nd, _mm256_setzero_ps(), _CMP_LT_OQ));
+            }
+            const auto outsideBits = static_cast<uint32>(_mm256_movemask_ps(outside));
+            const auto crossingBits = static_cast<uint32>(_mm256_movemask_ps(crossing));
+            setBits(visible, i, ~outsideBits & 0xFF);
+            setBits(intersecting, i, ~outsideBits & crossingBits & 0xFF);
+        }
+        _mm256_zeroupper();
+        return i;
+    }
+#endif
+}
+
 Frustum makeFrustum(const Matrix44& m)
 {
     const auto col0 = m.column(0);
@@ -39,4 +177,29 @@ Frustum makeFrustum(const Matrix44& m)
     return frustum;
 }
 
+void cullBoxes(const Frustum& frustum, const AxisAlignedBoxArrays& boxes, size_t n,
+    uint32* visible, uint32* intersecting)
+{
+    check(visible);
+
+    const auto numWords = (n + 31) / 32;
+    std::fill(visible, visible + numWords, 0);
+    if (intersecting)
+    {
+        std::fill(intersecting, intersecting + numWords, 0);
+    }
+
+    CullPlane planes[6];
+    setupCullPlanes(frustum, boxes, planes);
+
+    size_t done = 0;
+#ifdef GF_SSE
+    // Lane groups of 4 and 8 never straddle a 32 bit word
+    done = cpuFeatures().avx ?
+        cullAVX(planes, n, visible, intersecting) :
+        cullSSE(planes, n, visible, intersecting);
+#endif
+    cullScalar(planes, done, n, visible, intersecting);
+}
+
 GF_NAMESPACE_END
\ No newline at end of file
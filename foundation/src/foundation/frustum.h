@@ -2,6 +2,7 @@
 #define GAMEFRIENDS_FRUSTUM_H
 
 #include "plane.h"
+#include "axisalignedbox.h"
 #include "vector3.h"
 #include "prerequest.h"
 
@@ -34,6 +35,12 @@ struct Frustum
 
 Frustum makeFrustum(const Matrix44& m);
 
+/// Bit (i % 32) of word (i / 32) is set when box i is at least partially inside.
+/// intersecting (optional) gets the subset of visible boxes that cross a plane.
+/// Both masks need (n + 31) / 32 words.
+void cullBoxes(const Frustum& frustum, const AxisAlignedBoxArrays& boxes, size_t n,
+    uint32* visible, uint32* intersecting = nullptr);
+
 GF_NAMESPACE_END
 
 #endif
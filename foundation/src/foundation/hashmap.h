@@ -0,0 +1,547 @@
+#ifndef GAMEFRIENDS_HASHMAP_H
+#define GAMEFRIENDS_HASHMAP_H
+
+#include "stringref.h"
+#include "math.h"
+#include "exception.h"
+#include "prerequest.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <tuple>
+#include <iterator>
+#include <functional>
+#include <initializer_list>
+#include <algorithm>
+#include <new>
+
+GF_NAMESPACE_BEGIN
+
+/// Hashes std::string, const char* and StringRef alike, so lookups need no temporary string
+struct StringHash
+{
+    size_t operator ()(StringRef s) const noexcept
+    {
+        return static_cast<size_t>(hash64(s.data(), s.size()));
+    }
+};
+
+struct StringEqual
+{
+    bool operator ()(StringRef a, StringRef b) const noexcept
+    {
+        return a == b;
+    }
+};
+
+template <class K>
+struct HashOf : std::hash<K> {};
+
+template <>
+struct HashOf<std::string> : StringHash {};
+
+template <class K>
+struct EqualOf : std::equal_to<K> {};
+
+template <>
+struct EqualOf<std::string> : StringEqual {};
+
+/// Open addressing hash map with linear probing and Robin Hood ordering.
+/// Elements live in one flat array; erase shifts the following run back, so there are no tombstones.
+/// find/contains/erase accept any key type Hash and Eq accept (e.g. StringRef for std::string keys).
+/// Insert and erase invalidate iterators and references.
+template <class K, class V, class Hash = HashOf<K>, class Eq = EqualOf<K>>
+class HashMap
+{
+public:
+    using ValueType = std::pair<K, V>;
+
+    template <bool Const>
+    class IteratorBase
+    {
+    private:
+        friend class HashMap;
+        using Map = typename std::conditional<Const, const HashMap, HashMap>::type;
+
+        Map* map_;
+        size_t i_;
+
+        IteratorBase(Map* map, size_t i)
+            : map_(map)
+            , i_(i)
+        {
+        }
+
+        void skipEmpty()
+        {
+            while (i_ < map_->capacity_ && map_->meta_[i_] == 0)
+            {
+                ++i_;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ValueType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const ValueType*, ValueType*>::type;
+        using reference = typename std::conditional<Const, const ValueType&, ValueType&>::type;
+
+        IteratorBase()
+            : map_(nullptr)
+            , i_(0)
+        {
+        }
+
+        /// Iterator to CIterator
+        template <bool C, class = typename std::enable_if<Const && !C>::type>
+        IteratorBase(const IteratorBase<C>& it)
+            : map_(it.map_)
+            , i_(it.i_)
+        {
+        }
+
+        reference operator *() const { return map_->slots_[i_]; }
+        pointer operator ->() const { return map_->slots_ + i_; }
+
+        IteratorBase& operator ++()
+        {
+            ++i_;
+            skipEmpty();
+            return *this;
+        }
+
+        IteratorBase operator ++(int)
+        {
+            auto it = *this;
+            ++(*this);
+            return it;
+        }
+
+        bool operator ==(const IteratorBase& it) const { return i_ == it.i_; }
+        bool operator !=(const IteratorBase& it) const { return i_ != it.i_; }
+
+        template <bool C>
+        friend class IteratorBase;
+    };
+
+    using Iterator = IteratorBase<false>;
+    using CIterator = IteratorBase<true>;
+
+private:
+    /// meta_[i] is 0 for an empty slot, otherwise upper hash bits | (probe distance + 1)
+    static const uint32 DIST_MASK = 0xff;
+    static const size_t NPOS = static_cast<size_t>(-1);
+    static const size_t MIN_CAPACITY = 8;
+
+    std::unique_ptr<uint32[]> meta_;
+    ValueType* slots_;
+    size_t capacity_;
+    size_t size_;
+    Hash hash_;
+    Eq eq_;
+
+public:
+    explicit HashMap(const Hash& hash = Hash(), const Eq& eq = Eq())
+        : meta_()
+        , slots_(nullptr)
+        , capacity_(0)
+        , size_(0)
+        , hash_(hash)
+        , eq_(eq)
+    {
+    }
+
+    explicit HashMap(size_t n, const Hash& hash = Hash(), const Eq& eq = Eq())
+        : HashMap(hash, eq)
+    {
+        reserve(n);
+    }
+
+    HashMap(std::initializer_list<ValueType> il, const Hash& hash = Hash(), const Eq& eq = Eq())
+        : HashMap(hash, eq)
+    {
+        insert(std::cbegin(il), std::cend(il));
+    }
+
+    HashMap(const HashMap& x)
+        : HashMap(x.hash_, x.eq_)
+    {
+        if (x.size_ > 0)
+        {
+            allocate(x.capacity_);
+            for (size_t i = 0; i < capacity_; ++i)
+            {
+                if (x.meta_[i] != 0)
+                {
+                    new (slots_ + i) ValueType(x.slots_[i]);
+                    meta_[i] = x.meta_[i];
+                    ++size_;
+                }
+            }
+        }
+    }
+
+    HashMap(HashMap&& x) noexcept
+        : HashMap(x.hash_, x.eq_)
+    {
+        swap(x);
+    }
+
+    ~HashMap()
+    {
+        release();
+    }
+
+    HashMap& operator =(const HashMap& x)
+    {
+        HashMap(x).swap(*this);
+        return *this;
+    }
+
+    HashMap& operator =(HashMap&& x) noexcept
+    {
+        HashMap(std::move(x)).swap(*this);
+        return *this;
+    }
+
+    Iterator begin()    noexcept { Iterator it(this, 0); it.skipEmpty(); return it; }
+    Iterator end()      noexcept { return Iterator(this, capacity_); }
+    CIterator begin()   const noexcept { CIterator it(this, 0); it.skipEmpty(); return it; }
+    CIterator end()     const noexcept { return CIterator(this, capacity_); }
+    CIterator cbegin()  const noexcept { return begin(); }
+    CIterator cend()    const noexcept { return end(); }
+
+    size_t size()       const noexcept { return size_; }
+    size_t capacity()   const noexcept { return capacity_; }
+    bool empty()        const noexcept { return size_ == 0; }
+
+    /// Makes room for n elements without rehashing
+    void reserve(size_t n)
+    {
+        auto cap = MIN_CAPACITY;
+        while (cap * 7 < n * 8)
+        {
+            cap *= 2;
+        }
+        if (cap > capacity_)
+        {
+            rehash(cap);
+        }
+    }
+
+    void clear() noexcept
+    {
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+            if (meta_[i] != 0)
+            {
+                slots_[i].~ValueType();
+                meta_[i] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+    template <class Key>
+    Iterator find(const Key& key)
+    {
+        const auto i = findIndex(key, hashOf(key));
+        return i == NPOS ? end() : Iterator(this, i);
+    }
+
+    template <class Key>
+    CIterator find(const Key& key) const
+    {
+        const auto i = findIndex(key, hashOf(key));
+        return i == NPOS ? end() : CIterator(this, i);
+    }
+
+    template <class Key>
+    bool contains(const Key& key) const
+    {
+        return findIndex(key, hashOf(key)) != NPOS;
+    }
+
+    /// Constructs the value only if key is not present
+    template <class... Args>
+    std::pair<Iterator, bool> emplace(const K& key, Args&&... args)
+    {
+        return emplaceImpl(key, std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    std::pair<Iterator, bool> emplace(K&& key, Args&&... args)
+    {
+        return emplaceImpl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<Iterator, bool> insert(const ValueType& val) { return emplaceImpl(val.first, val.second); }
+    std::pair<Iterator, bool> insert(ValueType&& val) { return emplaceImpl(std::move(val.first), std::move(val.second)); }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        while (first != last)
+        {
+            insert(*first);
+            ++first;
+        }
+    }
+
+    /// Overwrites the value if key is present
+    template <class M>
+    std::pair<Iterator, bool> assign(const K& key, M&& val)
+    {
+        const auto i = findIndex(key, hashOf(key));
+        if (i != NPOS)
+        {
+            slots_[i].second = std::forward<M>(val);
+            return{ Iterator(this, i), false };
+        }
+        return emplaceImpl(key, std::forward<M>(val));
+    }
+
+    V& operator [](const K& key) { return emplaceImpl(key).first->second; }
+    V& operator [](K&& key) { return emplaceImpl(std::move(key)).first->second; }
+
+    template <class Key>
+    V& at(const Key& key)
+    {
+        const auto i = findIndex(key, hashOf(key));
+        check(i != NPOS);
+        return slots_[i].second;
+    }
+
+    template <class Key>
+    const V& at(const Key& key) const
+    {
+        const auto i = findIndex(key, hashOf(key));
+        check(i != NPOS);
+        return slots_[i].second;
+    }
+
+    template <class Key>
+    size_t erase(const Key& key)
+    {
+        const auto i = findIndex(key, hashOf(key));
+        if (i == NPOS)
+        {
+            return 0;
+        }
+        eraseIndex(i);
+        return 1;
+    }
+
+    void erase(Iterator pos)
+    {
+        erase(CIterator(pos));
+    }
+
+    void erase(CIterator pos)
+    {
+        check(pos.map_ == this && pos.i_ < capacity_ && meta_[pos.i_] != 0);
+        eraseIndex(pos.i_);
+    }
+
+    void swap(HashMap& x) noexcept
+    {
+        std::swap(meta_, x.meta_);
+        std::swap(slots_, x.slots_);
+        std::swap(capacity_, x.capacity_);
+        std::swap(size_, x.size_);
+        std::swap(hash_, x.hash_);
+        std::swap(eq_, x.eq_);
+    }
+
+private:
+    static uint64 mix(uint64 h) noexcept
+    {
+        // MurmurHash3 finalizer; std::hash of integers and pointers is the identity
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static uint32 tagOf(uint64 h) noexcept
+    {
+        return static_cast<uint32>(h >> 32) & ~DIST_MASK;
+    }
+
+    template <class Key>
+    uint64 hashOf(const Key& key) const
+    {
+        return mix(static_cast<uint64>(hash_(key)));
+    }
+
+    size_t next(size_t i) const noexcept { return (i + 1) & (capacity_ - 1); }
+    size_t prev(size_t i) const noexcept { return (i - 1) & (capacity_ - 1); }
+
+    template <class Key>
+    size_t findIndex(const Key& key, uint64 h) const
+    {
+        if (size_ == 0)
+        {
+            return NPOS;
+        }
+
+        auto i = static_cast<size_t>(h) & (capacity_ - 1);
+        auto tag = tagOf(h) | 1;
+        for (;;)
+        {
+            const auto m = meta_[i];
+            if (m == tag && eq_(slots_[i].first, key))
+            {
+                return i;
+            }
+            // Empty, or an element closer to its home than key would be: key is absent
+            if ((m & DIST_MASK) < (tag & DIST_MASK) || (tag & DIST_MASK) == DIST_MASK)
+            {
+                return NPOS;
+            }
+            i = next(i);
+            ++tag;
+        }
+    }
+
+    template <class KeyArg, class... Args>
+    std::pair<Iterator, bool> emplaceImpl(KeyArg&& key, Args&&... args)
+    {
+        const auto h = hashOf(key);
+        const auto found = findIndex(key, h);
+        if (found != NPOS)
+        {
+            return{ Iterator(this, found), false };
+        }
+
+        ValueType val(std::piecewise_construct,
+            std::forward_as_tuple(std::forward<KeyArg>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+
+        if ((size_ + 1) * 8 > capacity_ * 7)
+        {
+            rehash(capacity_ > 0 ? capacity_ * 2 : MIN_CAPACITY);
+        }
+        return{ Iterator(this, place(std::move(val), h)), true };
+    }
+
+    size_t place(ValueType&& val, uint64 h)
+    {
+        size_t i;
+        while ((i = openSlot(h)) == NPOS)
+        {
+            // More than 255 probes at a sane load means Hash is degenerate
+            check(capacity_ < (size_ + MIN_CAPACITY) * 64);
+            rehash(capacity_ * 2);
+        }
+        new (slots_ + i) ValueType(std::move(val));
+        ++size_;
+        return i;
+    }
+
+    /// Opens slot for hash h by shifting the rest of its run forward, then returns it.
+    /// Returns NPOS without changing anything if a probe distance would overflow.
+    size_t openSlot(uint64 h)
+    {
+        auto i = static_cast<size_t>(h) & (capacity_ - 1);
+        auto tag = tagOf(h) | 1;
+        while (meta_[i] != 0 && (meta_[i] & DIST_MASK) >= (tag & DIST_MASK))
+        {
+            if ((tag & DIST_MASK) == DIST_MASK)
+            {
+                return NPOS;
+            }
+            i = next(i);
+            ++tag;
+        }
+
+        auto last = i;
+        while (meta_[last] != 0)
+        {
+            if ((meta_[last] & DIST_MASK) == DIST_MASK)
+            {
+                return NPOS;
+            }
+            last = next(last);
+        }
+
+        if (last != i)
+        {
+            new (slots_ + last) ValueType(std::move(slots_[prev(last)]));
+            meta_[last] = meta_[prev(last)] + 1;
+            for (auto j = prev(last); j != i; j = prev(j))
+            {
+                slots_[j] = std::move(slots_[prev(j)]);
+                meta_[j] = meta_[prev(j)] + 1;
+            }
+            slots_[i].~ValueType();
+        }
+        meta_[i] = tag;
+        return i;
+    }
+
+    void eraseIndex(size_t i)
+    {
+        auto n = next(i);
+        while ((meta_[n] & DIST_MASK) > 1)
+        {
+            slots_[i] = std::move(slots_[n]);
+            meta_[i] = meta_[n] - 1;
+            i = n;
+            n = next(n);
+        }
+        slots_[i].~ValueType();
+        meta_[i] = 0;
+        --size_;
+    }
+
+    void allocate(size_t n)
+    {
+        check(n >= MIN_CAPACITY && (n & (n - 1)) == 0);
+        meta_.reset(new uint32[n]());
+        slots_ = std::allocator<ValueType>().allocate(n);
+        capacity_ = n;
+    }
+
+    void release() noexcept
+    {
+        if (slots_)
+        {
+            clear();
+            std::allocator<ValueType>().deallocate(slots_, capacity_);
+        }
+        meta_.reset();
+        slots_ = nullptr;
+        capacity_ = 0;
+    }
+
+    void rehash(size_t n)
+    {
+        HashMap tmp(hash_, eq_);
+        tmp.allocate(n);
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+            if (meta_[i] != 0)
+            {
+                tmp.place(std::move(slots_[i]), hashOf(slots_[i].first));
+            }
+        }
+        swap(tmp);
+    }
+};
+
+GF_NAMESPACE_END
+
+namespace std
+{
+    template <class K, class V, class H, class E>
+    void swap(GF_NAMESPACE::HashMap<K, V, H, E>& a, GF_NAMESPACE::HashMap<K, V, H, E>& b)
+    {
+        a.swap(b);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include "jobsystem.h"
+#include "exception.h"
+
+GF_NAMESPACE_BEGIN
+
+namespace
+{
+    const size_t NOT_WORKER = static_cast<size_t>(-1);
+    const int SPIN_COUNT = 64;
+
+    thread_local JobSystem* t_system = nullptr;
+    thread_local size_t t_index = NOT_WORKER;
+    thread_local uint32 t_random = 0x9e3779b9;
+
+    uint32 nextRandom()
+    {
+        // xorshift32
+        auto x = t_random;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        t_random = x;
+        return x;
+    }
+}
+
+JobSystem::JobSystem()
+    : workers_()
+    , injectedMutex_()
+    , injected_()
+    , numInjected_(0)
+    , pending_(0)
+    , sleepers_(0)
+    , sleepMutex_()
+    , wake_()
+    , running_(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    shutdown();
+}
+
+void JobSystem::startup(size_t numThreads)
+{
+    check(workers_.empty());
+
+    if (numThreads == 0)
+    {
+        numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    numThreads = numThreads < MAX_THREADS ? numThreads : MAX_THREADS;
+
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        workers_.emplace_back(std::make_unique<Worker>());
+    }
+
+    t_system = this;
+    t_index = 0;
+
+    running_.store(true);
+    for (size_t i = 1; i < numThreads; ++i)
+    {
+        workers_[i]->thread = std::thread([this, i] { workerMain(i); });
+    }
+}
+
+void JobSystem::shutdown()
+{
+    if (workers_.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        running_.store(false);
+        wake_.notify_all();
+    }
+
+    for (auto& w : workers_)
+    {
+        if (w->thread.joinable())
+        {
+            w->thread.join();
+        }
+    }
+
+    check(pending_.load() == 0);
+    workers_.clear();
+
+    if (t_system == this)
+    {
+        t_system = nullptr;
+        t_index = NOT_WORKER;
+    }
+}
+
+size_t JobSystem::numThreads() const
+{
+    return std::max<size_t>(workers_.size(), 1);
+}
+
+void JobSystem::run(Job& job, JobCounter& counter)
+{
+    run(&job, 1, counter);
+}
+
+void JobSystem::run(Job* jobs, size_t n, JobCounter& counter)
+{
+    counter.count_.fetch_add(static_cast<int32>(n), std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i)
+    {
+        jobs[i].counter = &counter;
+        push(jobs + i);
+    }
+}
+
+void JobSystem::runAfter(JobCounter& dependency, Job& job, JobCounter& counter)
+{
+    counter.count_.fetch_add(1, std::memory_order_relaxed);
+    job.counter = &counter;
+
+    {
+        std::lock_guard<std::mutex> lock(dependency.mutex_);
+        if (!dependency.done())
+        {
+            dependency.continuations_.push_back(&job);
+            return;
+        }
+    }
+    push(&job);
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    auto spins = 0;
+    while (!counter.done())
+    {
+        if (runOne())
+        {
+            spins = 0;
+        }
+        else if (++spins > SPIN_COUNT)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // The thread that finished the counter may still hold the lock it reached zero under
+    std::lock_guard<std::mutex> lock(counter.mutex_);
+}
+
+void JobSystem::push(Job* job)
+{
+    if (workers_.empty())
+    {
+        execute(job);
+        return;
+    }
+
+    if (t_system == this)
+    {
+        if (!workers_[t_index]->deque.push(job))
+        {
+            // Full, run now instead of blocking
+            execute(job);
+            return;
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(injectedMutex_);
+        injected_.push_back(job);
+        numInjected_.fetch_add(1);
+    }
+
+    pending_.fetch_add(1);
+    if (sleepers_.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        wake_.notify_one();
+    }
+}
+
+Job* JobSystem::take()
+{
+    Job* job = nullptr;
+
+    if (t_system == this && workers_[t_index]->deque.pop(job))
+    {
+        return job;
+    }
+
+    if (numInjected_.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock(injectedMutex_);
+        if (!injected_.empty())
+        {
+            job = injected_.front();
+            injected_.pop_front();
+            numInjected_.fetch_sub(1);
+            return job;
+        }
+    }
+
+    // Start at a random victim so thieves spread out
+    const auto self = t_system == this ? t_index : NOT_WORKER;
+    const auto n = workers_.size();
+    const auto first = nextRandom() % n;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto victim = (first + i) % n;
+        if (victim != self && workers_[victim]->deque.steal(job))
+        {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+bool JobSystem::runOne()
+{
+    if (workers_.empty())
+    {
+        return false;
+    }
+
+    const auto job = take();
+    if (!job)
+    {
+        return false;
+    }
+
+    pending_.fetch_sub(1);
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(Job* job)
+{
+    // The job may be released as soon as its counter reaches zero
+    const auto counter = job->counter;
+    job->fn(job->data);
+    if (counter)
+    {
+        finish(*counter);
+    }
+}
+
+void JobSystem::finish(JobCounter& counter)
+{
+    // Only the decrement that may reach zero takes the lock
+    auto count = counter.count_.load(std::memory_order_relaxed);
+    while (count > 1)
+    {
+        if (counter.count_.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+
+    std::vector<Job*> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter.mutex_);
+        if (counter.count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            continuations.swap(counter.continuations_);
+        }
+    }
+
+    for (const auto job : continuations)
+    {
+        push(job);
+    }
+}
+
+void JobSystem::workerMain(size_t index)
+{
+    t_system = this;
+    t_index = index;
+    t_random = static_cast<uint32>(index * 0x9e3779b9u + 1);
+
+    while (running_.load())
+    {
+        if (runOne())
+        {
+            continue;
+        }
+
+        auto spins = 0;
+        while (pending_.load() <= 0 && running_.load() && ++spins < SPIN_COUNT)
+        {
+            std::this_thread::yield();
+        }
+        if (pending_.load() > 0)
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepers_.fetch_add(1);
+        wake_.wait(lock, [this] { return pending_.load() > 0 || !running_.load(); });
+        sleepers_.fetch_sub(1);
+    }
+}
+
+JobSystem jobSystem;
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,237 @@
+#ifndef GAMEFRIENDS_JOBSYSTEM_H
+#define GAMEFRIENDS_JOBSYSTEM_H
+
+#include "workstealingdeque.h"
+#include "prerequest.h"
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+
+GF_NAMESPACE_BEGIN
+
+class JobCounter;
+
+/// Unit of work. The submitter owns the storage, which must live until the counter it was run with reaches zero.
+struct Job
+{
+    using Function = void (*)(void* data);
+
+    Function fn;
+    void* data;
+    JobCounter* counter; /// Set by JobSystem::run
+};
+
+namespace detail
+{
+    template <class F>
+    void invokeJob(void* data)
+    {
+        (*static_cast<F*>(data))();
+    }
+}
+
+/// Job calling f(), which must outlive the job
+template <class F>
+Job makeJob(F& f)
+{
+    return Job{ &detail::invokeJob<F>, &f, nullptr };
+}
+
+/// Number of unfinished jobs run with it. Jobs registered by runAfter start when it reaches zero.
+/// It only reaches zero under mutex_, so runAfter cannot miss the release, and JobSystem::wait
+/// takes the mutex before returning, so the counter may be destroyed once wait returns.
+class JobCounter
+{
+private:
+    friend class JobSystem;
+
+    std::atomic<int32> count_;
+    std::mutex mutex_;
+    std::vector<Job*> continuations_;
+
+public:
+    JobCounter()
+        : count_(0)
+    {
+    }
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator =(const JobCounter&) = delete;
+
+    bool done() const
+    {
+        return count_.load(std::memory_order_acquire) == 0;
+    }
+};
+
+/// Work stealing thread pool.
+/// Every thread owns a Chase-Lev deque; idle threads steal from the others and sleep when nothing is queued.
+/// The thread calling startup() is thread 0 and only runs jobs while it waits.
+class JobSystem
+{
+public:
+    static const size_t MAX_THREADS = 64;
+
+private:
+    struct Worker
+    {
+        WorkStealingDeque<Job*> deque;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    /// Jobs from threads without a deque
+    std::mutex injectedMutex_;
+    std::deque<Job*> injected_;
+    std::atomic<int32> numInjected_;
+
+    std::atomic<int32> pending_;
+    std::atomic<int32> sleepers_;
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> running_;
+
+public:
+    JobSystem();
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator =(const JobSystem&) = delete;
+
+    /// numThreads includes the calling thread. 0 means one per hardware thread.
+    void startup(size_t numThreads = 0);
+    void shutdown();
+
+    /// 1 when not started; jobs then run inline.
+    size_t numThreads() const;
+
+    void run(Job& job, JobCounter& counter);
+    void run(Job* jobs, size_t n, JobCounter& counter);
+
+    /// Runs job once dependency reaches zero
+    void runAfter(JobCounter& dependency, Job& job, JobCounter& counter);
+
+    /// Runs queued jobs on the calling thread until counter reaches zero.
+    /// Use it rather than done() before destroying a counter.
+    void wait(JobCounter& counter);
+
+    /// Calls f(first, last) over chunks of [begin, end) of about grain elements.
+    /// The calling thread takes part. f must not throw.
+    template <class F>
+    void parallelFor(size_t begin, size_t end, size_t grain, F&& f);
+
+    /// Folds map(first, last) of each chunk with combine, starting from identity.
+    /// Partials are combined in chunk order, so the result does not depend on scheduling.
+    template <class T, class Map, class Combine>
+    T parallelReduce(size_t begin, size_t end, size_t grain, const T& identity, Map&& map, Combine&& combine);
+
+private:
+    void push(Job* job);
+    Job* take();
+    bool runOne();
+    void execute(Job* job);
+    void finish(JobCounter& counter);
+    void workerMain(size_t index);
+};
+
+template <class F>
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grain, F&& f)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    grain = std::max<size_t>(grain, 1);
+    const auto numChunks = (end - begin + grain - 1) / grain;
+    const auto numJobs = std::min(numChunks, numThreads());
+    if (numJobs <= 1)
+    {
+        f(begin, end);
+        return;
+    }
+
+    // Jobs claim chunks from a shared index, so uneven chunks balance out
+    struct Shared
+    {
+        std::atomic<size_t> next;
+        size_t begin;
+        size_t end;
+        size_t grain;
+        size_t numChunks;
+        typename std::remove_reference<F>::type* f;
+
+        static void body(void* data)
+        {
+            auto& s = *static_cast<Shared*>(data);
+            for (auto c = s.next.fetch_add(1, std::memory_order_relaxed); c < s.numChunks;
+                c = s.next.fetch_add(1, std::memory_order_relaxed))
+            {
+                const auto first = s.begin + c * s.grain;
+                (*s.f)(first, std::min(first + s.grain, s.end));
+            }
+        }
+    };
+
+    Shared shared;
+    shared.next = 0;
+    shared.begin = begin;
+    shared.end = end;
+    shared.grain = grain;
+    shared.numChunks = numChunks;
+    shared.f = &f;
+
+    Job jobs[MAX_THREADS];
+    for (size_t i = 0; i < numJobs - 1; ++i)
+    {
+        jobs[i] = Job{ &Shared::body, &shared, nullptr };
+    }
+
+    JobCounter counter;
+    run(jobs, numJobs - 1, counter);
+    Shared::body(&shared);
+    wait(counter);
+}
+
+template <class T, class Map, class Combine>
+T JobSystem::parallelReduce(size_t begin, size_t end, size_t grain, const T& identity, Map&& map, Combine&& combine)
+{
+    if (begin >= end)
+    {
+        return identity;
+    }
+
+    grain = std::max<size_t>(grain, 1);
+    const auto numChunks = (end - begin + grain - 1) / grain;
+
+    std::vector<T> partials(numChunks, identity);
+    parallelFor(0, numChunks, 1, [&](size_t first, size_t last)
+    {
+        for (auto c = first; c < last; ++c)
+        {
+            const auto b = begin + c * grain;
+            partials[c] = map(b, std::min(b + grain, end));
+        }
+    });
+
+    auto result = identity;
+    for (const auto& p : partials)
+    {
+        result = combine(result, p);
+    }
+    return result;
+}
+
+extern JobSystem jobSystem;
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
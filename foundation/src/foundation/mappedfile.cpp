@@ -0,0 +1,217 @@
+#include "mappedfile.h"
+#include "exception.h"
+#include <utility>
+
+#ifdef GF_WINDOWS
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <Windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+GF_NAMESPACE_BEGIN
+
+namespace
+{
+    const char EMPTY[1] = {};
+
+    /// Returns nullptr on failure
+    const char* mapFile(const std::string& path, size_t& size)
+    {
+#ifdef GF_WINDOWS
+        const auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || static_cast<uint64>(fileSize.QuadPart) > static_cast<size_t>(-1))
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        size = static_cast<size_t>(fileSize.QuadPart);
+        if (size == 0)
+        {
+            CloseHandle(file);
+            return EMPTY;
+        }
+
+        // The view keeps the mapping and the file alive after the handles are closed
+        const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+        {
+            return nullptr;
+        }
+
+        const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        return static_cast<const char*>(view);
+#else
+        const auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+
+        size = static_cast<size_t>(st.st_size);
+        if (size == 0)
+        {
+            ::close(fd);
+            return EMPTY;
+        }
+
+        const auto view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        madvise(view, size, MADV_SEQUENTIAL);
+        return static_cast<const char*>(view);
+#endif
+    }
+
+    size_t pageSize()
+    {
+#ifdef GF_WINDOWS
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#else
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    void unmapFile(const char* data, size_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+#ifdef GF_WINDOWS
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<char*>(data), size);
+#endif
+    }
+}
+
+MappedFile::MappedFile() noexcept
+    : data_(nullptr)
+    , size_(0)
+{
+}
+
+MappedFile::MappedFile(const std::string& path)
+    : MappedFile()
+{
+    open(path);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& that) noexcept
+    : data_(that.data_)
+    , size_(that.size_)
+{
+    that.data_ = nullptr;
+    that.size_ = 0;
+}
+
+MappedFile& MappedFile::operator =(MappedFile&& that) noexcept
+{
+    if (this != &that)
+    {
+        close();
+        std::swap(data_, that.data_);
+        std::swap(size_, that.size_);
+    }
+    return *this;
+}
+
+void MappedFile::open(const std::string& path)
+{
+    close();
+
+    size_t size = 0;
+    const auto data = mapFile(path, size);
+    enforce<FileException>(data, "Failed to open file (" + path + ").");
+
+    data_ = data;
+    size_ = size;
+}
+
+void MappedFile::close() noexcept
+{
+    if (data_)
+    {
+        unmapFile(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+bool MappedFile::isOpen() const noexcept
+{
+    return data_ != nullptr;
+}
+
+const char* MappedFile::data() const noexcept
+{
+    return data_;
+}
+
+size_t MappedFile::size() const noexcept
+{
+    return size_;
+}
+
+StringRef MappedFile::str() const noexcept
+{
+    return StringRef(data_ ? data_ : EMPTY, size_);
+}
+
+void MappedFile::release(size_t offset, size_t size) const noexcept
+{
+    static const auto PAGE_BYTES = pageSize();
+
+    check(offset <= size_ && size <= size_ - offset);
+    const auto begin = reinterpret_cast<uintptr_t>(data_ + offset + PAGE_BYTES - 1) / PAGE_BYTES * PAGE_BYTES;
+    const auto end = reinterpret_cast<uintptr_t>(data_ + offset + size) / PAGE_BYTES * PAGE_BYTES;
+    if (size_ == 0 || begin >= end)
+    {
+        return;
+    }
+
+#ifdef GF_WINDOWS
+    // Unlocking pages that are not locked removes them from the working set
+    VirtualUnlock(reinterpret_cast<void*>(begin), end - begin);
+#else
+    madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+#endif
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef GAMEFRIENDS_MAPPEDFILE_H
+#define GAMEFRIENDS_MAPPEDFILE_H
+
+#include "stringref.h"
+#include "prerequest.h"
+#include <string>
+
+GF_NAMESPACE_BEGIN
+
+/// Read-only memory mapping of a whole file.
+class MappedFile
+{
+private:
+    const char* data_;
+    size_t size_;
+
+public:
+    MappedFile() noexcept;
+    explicit MappedFile(const std::string& path) noexcept(false);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator =(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& that) noexcept;
+    MappedFile& operator =(MappedFile&& that) noexcept;
+
+    /// Throws FileException when the file cannot be opened
+    void open(const std::string& path) noexcept(false);
+    void close() noexcept;
+
+    bool isOpen() const noexcept;
+
+    /// Not null terminated. An empty file has size 0 and a non-null data.
+    const char* data() const noexcept;
+    size_t size() const noexcept;
+    StringRef str() const noexcept;
+
+    /// Drops the whole pages within [offset, offset + size) from memory. They are read from the file again on next access.
+    void release(size_t offset, size_t size) const noexcept;
+};
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
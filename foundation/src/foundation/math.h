@@ -4,17 +4,29 @@
 #include "exception.h"
 #include "prerequest.h"
 #include <string>
+#include <cmath>
 
 GF_NAMESPACE_BEGIN
 
-extern const float PI;		/// 3.141592...
-extern const float PI_2;	/// PI/2
-extern const float PI_4;	/// PI/4
-extern const float EPSILON; /// 0.0001f
+constexpr float PI = 3.14159265358979323846264338327950288f;
+constexpr float PI_2 = PI / 2;
+constexpr float PI_4 = PI / 4;
+constexpr float EPSILON = 0.0001f;
 
-float radian(float deg) noexcept;
-float degree(float rad) noexcept;
-bool equalf(float a, float b) noexcept;
+constexpr float radian(float deg) noexcept
+{
+    return deg * PI / 180;
+}
+
+constexpr float degree(float rad) noexcept
+{
+    return rad * 180 / PI;
+}
+
+inline bool equalf(float a, float b) noexcept
+{
+    return std::abs(a - b) < EPSILON;
+}
 
 template <class T>
 T ceiling(T n, T base) noexcept
@@ -22,8 +34,28 @@ T ceiling(T n, T base) noexcept
     return static_cast<T>(static_cast<unsigned long long>((n + base - 1) / base)) * base;
 }
 
+/// Smallest 2-power not less than n
+template <class T>
+T ceilingPow2(T n) noexcept
+{
+    T p = 1;
+    while (p < n)
+    {
+        p <<= 1;
+    }
+    return p;
+}
+
+/// CRC-32 (IEEE 802.3). Slicing-by-8, or the ARMv8 CRC instructions when compiled in.
 unsigned crc32(const void* p, size_t length) noexcept;
 
+/// CRC-32C (Castagnoli). Uses SSE4.2 when the CPU has it.
+/// Different values from crc32(), so do not mix them in one table.
+unsigned crc32c(const void* p, size_t length) noexcept;
+
+/// 64 bit non-cryptographic hash, same values as XXH64
+uint64 hash64(const void* p, size_t length, uint64 seed = 0) noexcept;
+
 template <class It>
 unsigned hashCombine(It b, It e)
 {
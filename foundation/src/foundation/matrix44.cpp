@@ -3,273 +3,340 @@
 #include "vector4.h"
 #include "math.h"
 #include "exception.h"
+#include "cpu.h"
 #include <algorithm>
 #include <memory>
 #include <cmath>
 
+#ifdef GF_SSE
+    #include <immintrin.h>
+#endif
+
 GF_NAMESPACE_BEGIN
 
-const Matrix44 Matrix44::IDENTITY = {
+const Matrix44 Matrix44::IDENTITY(
     1, 0, 0, 0,
     0, 1, 0, 0,
     0, 0, 1, 0,
     0, 0, 0, 1
-};
-
-Matrix44::Matrix44(
-    float n00, float n01, float n02, float n03,
-    float n10, float n11, float n12, float n13,
-    float n20, float n21, float n22, float n23,
-    float n30, float n31, float n32, float n33
-    )
-    : m_()
-{
-    m_[0][0] = n00;
-    m_[0][1] = n01;
-    m_[0][2] = n02;
-    m_[0][3] = n03;
-
-    m_[1][0] = n10;
-    m_[1][1] = n11;
-    m_[1][2] = n12;
-    m_[1][3] = n13;
-
-    m_[2][0] = n20;
-    m_[2][1] = n21;
-    m_[2][2] = n22;
-    m_[2][3] = n23;
-
-    m_[3][0] = n30;
-    m_[3][1] = n31;
-    m_[3][2] = n32;
-    m_[3][3] = n33;
-}
+    );
 
-Matrix44::Matrix44(std::initializer_list<float> il)
-    : m_()
+namespace
 {
-    *this = il;
-}
+    using Rows = const float(*)[4];
 
-void Matrix44::swap(Matrix44& that)
-{
-    for (int r = 0; r < 4; ++r)
+    Rows rows(const Matrix44& m)
     {
-        for (int c = 0; c < 4; ++c)
-        {
-            std::swap(m_[r][c], that.m_[r][c]);
-        }
+        return reinterpret_cast<Rows>(m.data());
     }
-}
 
-Matrix44& Matrix44::operator =(std::initializer_list<float> il)
-{
-    check(il.size() == 16);
+    // Scalar reference kernels
 
-    auto it = std::begin(il);
-    for (int r = 0; r < 4; ++r)
+    float determinantScalar(const Matrix44& mat)
     {
-        for (int c = 0; c < 4; ++c)
-        {
-            m_[r][c] = *it;
-            ++it;
-        }
+        const auto m = rows(mat);
+        return (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
+            (m[0][0] * m[1][2] - m[0][2] * m[1][0]) * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) +
+            (m[0][0] * m[1][3] - m[0][3] * m[1][0]) * (m[2][1] * m[3][2] - m[2][2] * m[3][1]) +
+            (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) -
+            (m[0][1] * m[1][3] - m[0][3] * m[1][1]) * (m[2][0] * m[3][2] - m[2][2] * m[3][0]) +
+            (m[0][2] * m[1][3] - m[0][3] * m[1][2]) * (m[2][0] * m[3][1] - m[2][1] * m[3][0]);
     }
-    return *this;
-}
 
-const float& Matrix44::operator ()(size_t r, size_t c) const
-{
-    return const_cast<Matrix44&>(*this)(r, c);
-}
+    Matrix44 transposeScalar(const Matrix44& mat)
+    {
+        const auto m = rows(mat);
+        return{
+            m[0][0], m[1][0], m[2][0], m[3][0],
+            m[0][1], m[1][1], m[2][1], m[3][1],
+            m[0][2], m[1][2], m[2][2], m[3][2],
+            m[0][3], m[1][3], m[2][3], m[3][3]
+        };
+    }
 
-float& Matrix44::operator ()(size_t r, size_t c)
-{
-    check(r < 4 && c < 4);
-    return m_[r][c];
-}
+    Matrix44 inverseScalar(const Matrix44& mat, float det)
+    {
+        const auto m = rows(mat);
+        const auto invDet = 1 / det;
+        return{
+            invDet * (m[1][1] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) + m[1][2] * (m[2][3] * m[3][1] - m[2][1] * m[3][3]) + m[1][3] * (m[2][1] * m[3][2] - m[2][2] * m[3][1])),
+            invDet * (m[2][1] * (m[0][2] * m[3][3] - m[0][3] * m[3][2]) + m[2][2] * (m[0][3] * m[3][1] - m[0][1] * m[3][3]) + m[2][3] * (m[0][1] * m[3][2] - m[0][2] * m[3][1])),
+            invDet * (m[3][1] * (m[0][2] * m[1][3] - m[0][3] * m[1][2]) + m[3][2] * (m[0][3] * m[1][1] - m[0][1] * m[1][3]) + m[3][3] * (m[0][1] * m[1][2] - m[0][2] * m[1][1])),
+            invDet * (m[0][1] * (m[1][3] * m[2][2] - m[1][2] * m[2][3]) + m[0][2] * (m[1][1] * m[2][3] - m[1][3] * m[2][1]) + m[0][3] * (m[1][2] * m[2][1] - m[1][1] * m[2][2])),
+
+            invDet * (m[1][2] * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) + m[1][3] * (m[2][2] * m[3][0] - m[2][0] * m[3][2]) + m[1][0] * (m[2][3] * m[3][2] - m[2][2] * m[3][3])),
+            invDet * (m[2][2] * (m[0][0] * m[3][3] - m[0][3] * m[3][0]) + m[2][3] * (m[0][2] * m[3][0] - m[0][0] * m[3][2]) + m[2][0] * (m[0][3] * m[3][2] - m[0][2] * m[3][3])),
+            invDet * (m[3][2] * (m[0][0] * m[1][3] - m[0][3] * m[1][0]) + m[3][3] * (m[0][2] * m[1][0] - m[0][0] * m[1][2]) + m[3][0] * (m[0][3] * m[1][2] - m[0][2] * m[1][3])),
+            invDet * (m[0][2] * (m[1][3] * m[2][0] - m[1][0] * m[2][3]) + m[0][3] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) + m[0][0] * (m[1][2] * m[2][3] - m[1][3] * m[2][2])),
+
+            invDet * (m[1][3] * (m[2][0] * m[3][1] - m[2][1] * m[3][0]) + m[1][0] * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) + m[1][1] * (m[2][3] * m[3][0] - m[2][0] * m[3][3])),
+            invDet * (m[2][3] * (m[0][0] * m[3][1] - m[0][1] * m[3][0]) + m[2][0] * (m[0][1] * m[3][3] - m[0][3] * m[3][1]) + m[2][1] * (m[0][3] * m[3][0] - m[0][0] * m[3][3])),
+            invDet * (m[3][3] * (m[0][0] * m[1][1] - m[0][1] * m[1][0]) + m[3][0] * (m[0][1] * m[1][3] - m[0][3] * m[1][1]) + m[3][1] * (m[0][3] * m[1][0] - m[0][0] * m[1][3])),
+            invDet * (m[0][3] * (m[1][1] * m[2][0] - m[1][0] * m[2][1]) + m[0][0] * (m[1][3] * m[2][1] - m[1][1] * m[2][3]) + m[0][1] * (m[1][0] * m[2][3] - m[1][3] * m[2][0])),
+
+            invDet * (m[1][0] * (m[2][2] * m[3][1] - m[2][1] * m[3][2]) + m[1][1] * (m[2][0] * m[3][2] - m[2][2] * m[3][0]) + m[1][2] * (m[2][1] * m[3][0] - m[2][0] * m[3][1])),
+            invDet * (m[2][0] * (m[0][2] * m[3][1] - m[0][1] * m[3][2]) + m[2][1] * (m[0][0] * m[3][2] - m[0][2] * m[3][0]) + m[2][2] * (m[0][1] * m[3][0] - m[0][0] * m[3][1])),
+            invDet * (m[3][0] * (m[0][2] * m[1][1] - m[0][1] * m[1][2]) + m[3][1] * (m[0][0] * m[1][2] - m[0][2] * m[1][0]) + m[3][2] * (m[0][1] * m[1][0] - m[0][0] * m[1][1])),
+            invDet * (m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) + m[0][1] * (m[1][2] * m[2][0] - m[1][0] * m[2][2]) + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]))
+        };
+    }
 
-Vector4 Matrix44::row(size_t r) const
-{
-    return{ m_[r][0], m_[r][1], m_[r][2], m_[r][3] };
-}
+    Matrix44 multiplyScalar(const Matrix44& a, const Matrix44& b)
+    {
+        return{
+            a(0, 0) * b(0, 0) + a(0, 1) * b(1, 0) + a(0, 2) * b(2, 0) + a(0, 3) * b(3, 0),
+            a(0, 0) * b(0, 1) + a(0, 1) * b(1, 1) + a(0, 2) * b(2, 1) + a(0, 3) * b(3, 1),
+            a(0, 0) * b(0, 2) + a(0, 1) * b(1, 2) + a(0, 2) * b(2, 2) + a(0, 3) * b(3, 2),
+            a(0, 0) * b(0, 3) + a(0, 1) * b(1, 3) + a(0, 2) * b(2, 3) + a(0, 3) * b(3, 3),
+
+            a(1, 0) * b(0, 0) + a(1, 1) * b(1, 0) + a(1, 2) * b(2, 0) + a(1, 3) * b(3, 0),
+            a(1, 0) * b(0, 1) + a(1, 1) * b(1, 1) + a(1, 2) * b(2, 1) + a(1, 3) * b(3, 1),
+            a(1, 0) * b(0, 2) + a(1, 1) * b(1, 2) + a(1, 2) * b(2, 2) + a(1, 3) * b(3, 2),
+            a(1, 0) * b(0, 3) + a(1, 1) * b(1, 3) + a(1, 2) * b(2, 3) + a(1, 3) * b(3, 3),
+
+            a(2, 0) * b(0, 0) + a(2, 1) * b(1, 0) + a(2, 2) * b(2, 0) + a(2, 3) * b(3, 0),
+            a(2, 0) * b(0, 1) + a(2, 1) * b(1, 1) + a(2, 2) * b(2, 1) + a(2, 3) * b(3, 1),
+            a(2, 0) * b(0, 2) + a(2, 1) * b(1, 2) + a(2, 2) * b(2, 2) + a(2, 3) * b(3, 2),
+            a(2, 0) * b(0, 3) + a(2, 1) * b(1, 3) + a(2, 2) * b(2, 3) + a(2, 3) * b(3, 3),
+
+            a(3, 0) * b(0, 0) + a(3, 1) * b(1, 0) + a(3, 2) * b(2, 0) + a(3, 3) * b(3, 0),
+            a(3, 0) * b(0, 1) + a(3, 1) * b(1, 1) + a(3, 2) * b(2, 1) + a(3, 3) * b(3, 1),
+            a(3, 0) * b(0, 2) + a(3, 1) * b(1, 2) + a(3, 2) * b(2, 2) + a(3, 3) * b(3, 2),
+            a(3, 0) * b(0, 3) + a(3, 1) * b(1, 3) + a(3, 2) * b(2, 3) + a(3, 3) * b(3, 3)
+        };
+    }
 
-Vector4 Matrix44::column(size_t c) const
-{
-    return{ m_[0][c], m_[1][c], m_[2][c], m_[3][c] };
-}
+#ifdef GF_SSE
+    /// Shuffle helpers are SSE1 only so that every x86/x64 target can take this path.
+    #define GF_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+    #define GF_SWIZZLE(v, x, y, z, w) GF_SHUFFLE(v, v, x, y, z, w)
 
-float Matrix44::determinant() const
-{
-    return (m_[0][0] * m_[1][1] - m_[0][1] * m_[1][0]) * (m_[2][2] * m_[3][3] - m_[2][3] * m_[3][2]) -
-        (m_[0][0] * m_[1][2] - m_[0][2] * m_[1][0]) * (m_[2][1] * m_[3][3] - m_[2][3] * m_[3][1]) +
-        (m_[0][0] * m_[1][3] - m_[0][3] * m_[1][0]) * (m_[2][1] * m_[3][2] - m_[2][2] * m_[3][1]) +
-        (m_[0][1] * m_[1][2] - m_[0][2] * m_[1][1]) * (m_[2][0] * m_[3][3] - m_[2][3] * m_[3][0]) -
-        (m_[0][1] * m_[1][3] - m_[0][3] * m_[1][1]) * (m_[2][0] * m_[3][2] - m_[2][2] * m_[3][0]) +
-        (m_[0][2] * m_[1][3] - m_[0][3] * m_[1][2]) * (m_[2][0] * m_[3][1] - m_[2][1] * m_[3][0]);
-}
+    // 2x2 row major blocks are packed in one register as | 0 1 |
+    //                                                   | 2 3 |
+    __m128 mat2Mul(__m128 a, __m128 b) /// a * b
+    {
+        return _mm_add_ps(
+            _mm_mul_ps(a, GF_SWIZZLE(b, 0, 3, 0, 3)),
+            _mm_mul_ps(GF_SWIZZLE(a, 1, 0, 3, 2), GF_SWIZZLE(b, 2, 1, 2, 1)));
+    }
 
-Matrix44 Matrix44::transpose() const
-{
-    return{
-        m_[0][0], m_[1][0], m_[2][0], m_[3][0],
-        m_[0][1], m_[1][1], m_[2][1], m_[3][1],
-        m_[0][2], m_[1][2], m_[2][2], m_[3][2],
-        m_[0][3], m_[1][3], m_[2][3], m_[3][3]
-    };
-}
+    __m128 mat2AdjMul(__m128 a, __m128 b) /// adj(a) * b
+    {
+        return _mm_sub_ps(
+            _mm_mul_ps(GF_SWIZZLE(a, 3, 3, 0, 0), b),
+            _mm_mul_ps(GF_SWIZZLE(a, 1, 1, 2, 2), GF_SWIZZLE(b, 2, 3, 0, 1)));
+    }
 
-Matrix44 Matrix44::inverse() const
-{
-    const auto det = determinant();
-    check(!equalf(det, 0));
-    const auto invDet = 1 / det;
-    return{
-        invDet * (m_[1][1] * (m_[2][2] * m_[3][3] - m_[2][3] * m_[3][2]) + m_[1][2] * (m_[2][3] * m_[3][1] - m_[2][1] * m_[3][3]) + m_[1][3] * (m_[2][1] * m_[3][2] - m_[2][2] * m_[3][1])),
-        invDet * (m_[2][1] * (m_[0][2] * m_[3][3] - m_[0][3] * m_[3][2]) + m_[2][2] * (m_[0][3] * m_[3][1] - m_[0][1] * m_[3][3]) + m_[2][3] * (m_[0][1] * m_[3][2] - m_[0][2] * m_[3][1])),
-        invDet * (m_[3][1] * (m_[0][2] * m_[1][3] - m_[0][3] * m_[1][2]) + m_[3][2] * (m_[0][3] * m_[1][1] - m_[0][1] * m_[1][3]) + m_[3][3] * (m_[0][1] * m_[1][2] - m_[0][2] * m_[1][1])),
-        invDet * (m_[0][1] * (m_[1][3] * m_[2][2] - m_[1][2] * m_[2][3]) + m_[0][2] * (m_[1][1] * m_[2][3] - m_[1][3] * m_[2][1]) + m_[0][3] * (m_[1][2] * m_[2][1] - m_[1][1] * m_[2][2])),
-
-        invDet * (m_[1][2] * (m_[2][0] * m_[3][3] - m_[2][3] * m_[3][0]) + m_[1][3] * (m_[2][2] * m_[3][0] - m_[2][0] * m_[3][2]) + m_[1][0] * (m_[2][3] * m_[3][2] - m_[2][2] * m_[3][3])),
-        invDet * (m_[2][2] * (m_[0][0] * m_[3][3] - m_[0][3] * m_[3][0]) + m_[2][3] * (m_[0][2] * m_[3][0] - m_[0][0] * m_[3][2]) + m_[2][0] * (m_[0][3] * m_[3][2] - m_[0][2] * m_[3][3])),
-        invDet * (m_[3][2] * (m_[0][0] * m_[1][3] - m_[0][3] * m_[1][0]) + m_[3][3] * (m_[0][2] * m_[1][0] - m_[0][0] * m_[1][2]) + m_[3][0] * (m_[0][3] * m_[1][2] - m_[0][2] * m_[1][3])),
-        invDet * (m_[0][2] * (m_[1][3] * m_[2][0] - m_[1][0] * m_[2][3]) + m_[0][3] * (m_[1][0] * m_[2][2] - m_[1][2] * m_[2][0]) + m_[0][0] * (m_[1][2] * m_[2][3] - m_[1][3] * m_[2][2])),
-
-        invDet * (m_[1][3] * (m_[2][0] * m_[3][1] - m_[2][1] * m_[3][0]) + m_[1][0] * (m_[2][1] * m_[3][3] - m_[2][3] * m_[3][1]) + m_[1][1] * (m_[2][3] * m_[3][0] - m_[2][0] * m_[3][3])),
-        invDet * (m_[2][3] * (m_[0][0] * m_[3][1] - m_[0][1] * m_[3][0]) + m_[2][0] * (m_[0][1] * m_[3][3] - m_[0][3] * m_[3][1]) + m_[2][1] * (m_[0][3] * m_[3][0] - m_[0][0] * m_[3][3])),
-        invDet * (m_[3][3] * (m_[0][0] * m_[1][1] - m_[0][1] * m_[1][0]) + m_[3][0] * (m_[0][1] * m_[1][3] - m_[0][3] * m_[1][1]) + m_[3][1] * (m_[0][3] * m_[1][0] - m_[0][0] * m_[1][3])),
-        invDet * (m_[0][3] * (m_[1][1] * m_[2][0] - m_[1][0] * m_[2][1]) + m_[0][0] * (m_[1][3] * m_[2][1] - m_[1][1] * m_[2][3]) + m_[0][1] * (m_[1][0] * m_[2][3] - m_[1][3] * m_[2][0])),
-
-        invDet * (m_[1][0] * (m_[2][2] * m_[3][1] - m_[2][1] * m_[3][2]) + m_[1][1] * (m_[2][0] * m_[3][2] - m_[2][2] * m_[3][0]) + m_[1][2] * (m_[2][1] * m_[3][0] - m_[2][0] * m_[3][1])),
-        invDet * (m_[2][0] * (m_[0][2] * m_[3][1] - m_[0][1] * m_[3][2]) + m_[2][1] * (m_[0][0] * m_[3][2] - m_[0][2] * m_[3][0]) + m_[2][2] * (m_[0][1] * m_[3][0] - m_[0][0] * m_[3][1])),
-        invDet * (m_[3][0] * (m_[0][2] * m_[1][1] - m_[0][1] * m_[1][2]) + m_[3][1] * (m_[0][0] * m_[1][2] - m_[0][2] * m_[1][0]) + m_[3][2] * (m_[0][1] * m_[1][0] - m_[0][0] * m_[1][1])),
-        invDet * (m_[0][0] * (m_[1][1] * m_[2][2] - m_[1][2] * m_[2][1]) + m_[0][1] * (m_[1][2] * m_[2][0] - m_[1][0] * m_[2][2]) + m_[0][2] * (m_[1][0] * m_[2][1] - m_[1][1] * m_[2][0]))
+    __m128 mat2MulAdj(__m128 a, __m128 b) /// a * adj(b)
+    {
+        return _mm_sub_ps(
+            _mm_mul_ps(a, GF_SWIZZLE(b, 3, 0, 3, 0)),
+            _mm_mul_ps(GF_SWIZZLE(a, 1, 0, 3, 2), GF_SWIZZLE(b, 2, 1, 2, 1)));
+    }
+
+    __m128 horizontalSum(__m128 v)
+    {
+        const auto s = _mm_add_ps(v, GF_SWIZZLE(v, 1, 0, 3, 2));
+        return _mm_add_ps(s, GF_SWIZZLE(s, 2, 3, 0, 1));
+    }
+
+    struct BlockInverse
+    {
+        __m128 det; /// |M| in all lanes
+        __m128 x, y, z, w; /// Adjugate blocks
     };
-}
 
-bool operator ==(const Matrix44& a, const Matrix44& b)
-{
-    return equalf(a(0, 0), b(0, 0)) && equalf(a(0, 1), b(0, 1)) && equalf(a(0, 2), b(0, 2)) && equalf(a(0, 3), b(0, 3))
-        && equalf(a(1, 0), b(1, 0)) && equalf(a(1, 1), b(1, 1)) && equalf(a(1, 2), b(1, 2)) && equalf(a(1, 3), b(1, 3))
-        && equalf(a(2, 0), b(2, 0)) && equalf(a(2, 1), b(2, 1)) && equalf(a(2, 2), b(2, 2)) && equalf(a(2, 3), b(2, 3))
-        && equalf(a(3, 0), b(3, 0)) && equalf(a(3, 1), b(3, 1)) && equalf(a(3, 2), b(3, 2)) && equalf(a(3, 3), b(3, 3));
-}
+    /// Block-wise inverse of | A B |
+    ///                       | C D |
+    BlockInverse blockInverse(const Matrix44& m)
+    {
+        const auto p = m.data();
+        const auto r0 = _mm_loadu_ps(p);
+        const auto r1 = _mm_loadu_ps(p + 4);
+        const auto r2 = _mm_loadu_ps(p + 8);
+        const auto r3 = _mm_loadu_ps(p + 12);
+
+        const auto A = _mm_movelh_ps(r0, r1);
+        const auto B = _mm_movehl_ps(r1, r0);
+        const auto C = _mm_movelh_ps(r2, r3);
+        const auto D = _mm_movehl_ps(r3, r2);
+
+        // (|A| |B| |C| |D|)
+        const auto detSub = _mm_sub_ps(
+            _mm_mul_ps(GF_SHUFFLE(r0, r2, 0, 2, 0, 2), GF_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+            _mm_mul_ps(GF_SHUFFLE(r0, r2, 1, 3, 1, 3), GF_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+        const auto detA = GF_SWIZZLE(detSub, 0, 0, 0, 0);
+        const auto detB = GF_SWIZZLE(detSub, 1, 1, 1, 1);
+        const auto detC = GF_SWIZZLE(detSub, 2, 2, 2, 2);
+        const auto detD = GF_SWIZZLE(detSub, 3, 3, 3, 3);
+
+        const auto D_C = mat2AdjMul(D, C);
+        const auto A_B = mat2AdjMul(A, B);
+
+        BlockInverse inv;
+        inv.x = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, D_C));
+        inv.w = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, A_B));
+        inv.y = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, A_B));
+        inv.z = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, D_C));
+
+        // |M| = |A||D| + |B||C| - tr(A#B D#C)
+        const auto tr = horizontalSum(_mm_mul_ps(A_B, GF_SWIZZLE(D_C, 0, 2, 1, 3)));
+        inv.det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+        return inv;
+    }
 
-bool operator !=(const Matrix44& a, const Matrix44& b)
-{
-    return !(a == b);
-}
+    float determinantSSE(const Matrix44& m)
+    {
+        return _mm_cvtss_f32(blockInverse(m).det);
+    }
 
-const Matrix44 operator +(const Matrix44& m)
-{
-    return m;
-}
+    Matrix44 transposeSSE(const Matrix44& m)
+    {
+        const auto p = m.data();
+        auto r0 = _mm_loadu_ps(p);
+        auto r1 = _mm_loadu_ps(p + 4);
+        auto r2 = _mm_loadu_ps(p + 8);
+        auto r3 = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+        Matrix44 t;
+        const auto q = t.data();
+        _mm_storeu_ps(q, r0);
+        _mm_storeu_ps(q + 4, r1);
+        _mm_storeu_ps(q + 8, r2);
+        _mm_storeu_ps(q + 12, r3);
+        return t;
+    }
 
-const Matrix44 operator -(const Matrix44& m)
-{
-    return{
-        -m(0, 0), -m(0, 1), -m(0, 2), -m(0, 3),
-        -m(1, 0), -m(1, 1), -m(1, 2), -m(1, 3),
-        -m(2, 0), -m(2, 1), -m(2, 2), -m(2, 3),
-        -m(3, 0), -m(3, 1), -m(3, 2), -m(3, 3)
-    };
-}
+    Matrix44 inverseSSE(const Matrix44& m, float)
+    {
+        const auto inv = blockInverse(m);
+        const auto rcpDet = _mm_div_ps(_mm_setr_ps(1, -1, -1, 1), inv.det);
+        const auto x = _mm_mul_ps(inv.x, rcpDet);
+        const auto y = _mm_mul_ps(inv.y, rcpDet);
+        const auto z = _mm_mul_ps(inv.z, rcpDet);
+        const auto w = _mm_mul_ps(inv.w, rcpDet);
+
+        // Adjugate shuffle and row store combined
+        Matrix44 r;
+        const auto q = r.data();
+        _mm_storeu_ps(q, GF_SHUFFLE(x, y, 3, 1, 3, 1));
+        _mm_storeu_ps(q + 4, GF_SHUFFLE(x, y, 2, 0, 2, 0));
+        _mm_storeu_ps(q + 8, GF_SHUFFLE(z, w, 3, 1, 3, 1));
+        _mm_storeu_ps(q + 12, GF_SHUFFLE(z, w, 2, 0, 2, 0));
+        return r;
+    }
 
-const Matrix44 operator +(const Matrix44& a, const Matrix44& b)
-{
-    return{
-        a(0, 0) + b(0, 0), a(0, 1) + b(0, 1), a(0, 2) + b(0, 2), a(0, 3) + b(0, 3),
-        a(1, 0) + b(1, 0), a(1, 1) + b(1, 1), a(1, 2) + b(1, 2), a(1, 3) + b(1, 3),
-        a(2, 0) + b(2, 0), a(2, 1) + b(2, 1), a(2, 2) + b(2, 2), a(2, 3) + b(2, 3),
-        a(3, 0) + b(3, 0), a(3, 1) + b(3, 1), a(3, 2) + b(3, 2), a(3, 3) + b(3, 3)
-    };
-}
+    /// Same summation order as multiplyScalar so results are bit-identical
+    Matrix44 multiplySSE(const Matrix44& a, const Matrix44& b)
+    {
+        const auto pa = a.data();
+        const auto pb = b.data();
+        const auto b0 = _mm_loadu_ps(pb);
+        const auto b1 = _mm_loadu_ps(pb + 4);
+        const auto b2 = _mm_loadu_ps(pb + 8);
+        const auto b3 = _mm_loadu_ps(pb + 12);
+
+        Matrix44 r;
+        const auto q = r.data();
+        for (int i = 0; i < 16; i += 4)
+        {
+            auto row = _mm_mul_ps(_mm_set1_ps(pa[i]), b0);
+            row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(pa[i + 1]), b1));
+            row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(pa[i + 2]), b2));
+            row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(pa[i + 3]), b3));
+            _mm_storeu_ps(q + i, row);
+        }
+        return r;
+    }
 
-const Matrix44 operator -(const Matrix44& a, const Matrix44& b)
-{
-    return{
-        a(0, 0) - b(0, 0), a(0, 1) - b(0, 1), a(0, 2) - b(0, 2), a(0, 3) - b(0, 3),
-        a(1, 0) - b(1, 0), a(1, 1) - b(1, 1), a(1, 2) - b(1, 2), a(1, 3) - b(1, 3),
-        a(2, 0) - b(2, 0), a(2, 1) - b(2, 1), a(2, 2) - b(2, 2), a(2, 3) - b(2, 3),
-        a(3, 0) - b(3, 0), a(3, 1) - b(3, 1), a(3, 2) - b(3, 2), a(3, 3) - b(3, 3)
-    };
-}
+    /// Two rows per iteration. No FMA so that it stays bit-identical to multiplyScalar.
+    GF_TARGET("avx") Matrix44 multiplyAVX(const Matrix44& a, const Matrix44& b)
+    {
+        const auto pa = a.data();
+        const auto pb = b.data();
+        const auto b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb));
+        const auto b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 4));
+        const auto b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 8));
+        const auto b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 12));
+
+        Matrix44 r;
+        const auto q = r.data();
+        for (int i = 0; i < 16; i += 8)
+        {
+            const auto rows = _mm256_loadu_ps(pa + i);
+            auto out = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b0);
+            out = _mm256_add_ps(out, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), b1));
+            out = _mm256_add_ps(out, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b2));
+            out = _mm256_add_ps(out, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b3));
+            _mm256_storeu_ps(q + i, out);
+        }
+        _mm256_zeroupper();
+        return r;
+    }
 
-const Matrix44 operator *(const Matrix44& a, const Matrix44& b)
-{
-    return{
-        a(0, 0) * b(0, 0) + a(0, 1) * b(1, 0) + a(0, 2) * b(2, 0) + a(0, 3) * b(3, 0),
-        a(0, 0) * b(0, 1) + a(0, 1) * b(1, 1) + a(0, 2) * b(2, 1) + a(0, 3) * b(3, 1),
-        a(0, 0) * b(0, 2) + a(0, 1) * b(1, 2) + a(0, 2) * b(2, 2) + a(0, 3) * b(3, 2),
-        a(0, 0) * b(0, 3) + a(0, 1) * b(1, 3) + a(0, 2) * b(2, 3) + a(0, 3) * b(3, 3),
-
-        a(1, 0) * b(0, 0) + a(1, 1) * b(1, 0) + a(1, 2) * b(2, 0) + a(1, 3) * b(3, 0),
-        a(1, 0) * b(0, 1) + a(1, 1) * b(1, 1) + a(1, 2) * b(2, 1) + a(1, 3) * b(3, 1),
-        a(1, 0) * b(0, 2) + a(1, 1) * b(1, 2) + a(1, 2) * b(2, 2) + a(1, 3) * b(3, 2),
-        a(1, 0) * b(0, 3) + a(1, 1) * b(1, 3) + a(1, 2) * b(2, 3) + a(1, 3) * b(3, 3),
-
-        a(2, 0) * b(0, 0) + a(2, 1) * b(1, 0) + a(2, 2) * b(2, 0) + a(2, 3) * b(3, 0),
-        a(2, 0) * b(0, 1) + a(2, 1) * b(1, 1) + a(2, 2) * b(2, 1) + a(2, 3) * b(3, 1),
-        a(2, 0) * b(0, 2) + a(2, 1) * b(1, 2) + a(2, 2) * b(2, 2) + a(2, 3) * b(3, 2),
-        a(2, 0) * b(0, 3) + a(2, 1) * b(1, 3) + a(2, 2) * b(2, 3) + a(2, 3) * b(3, 3),
-
-        a(3, 0) * b(0, 0) + a(3, 1) * b(1, 0) + a(3, 2) * b(2, 0) + a(3, 3) * b(3, 0),
-        a(3, 0) * b(0, 1) + a(3, 1) * b(1, 1) + a(3, 2) * b(2, 1) + a(3, 3) * b(3, 1),
-        a(3, 0) * b(0, 2) + a(3, 1) * b(1, 2) + a(3, 2) * b(2, 2) + a(3, 3) * b(3, 2),
-        a(3, 0) * b(0, 3) + a(3, 1) * b(1, 3) + a(3, 2) * b(2, 3) + a(3, 3) * b(3, 3)
-    };
-}
+    #undef GF_SWIZZLE
+    #undef GF_SHUFFLE
+#endif
 
-const Matrix44 operator *(const Matrix44& m, float k)
-{
-    return{
-        m(0, 0) * k, m(0, 1) * k, m(0, 2) * k, m(0, 3) * k,
-        m(1, 0) * k, m(1, 1) * k, m(1, 2) * k, m(1, 3) * k,
-        m(2, 0) * k, m(2, 1) * k, m(2, 2) * k, m(2, 3) * k,
-        m(3, 0) * k, m(3, 1) * k, m(3, 2) * k, m(3, 3) * k
+    struct Kernels
+    {
+        float(*determinant)(const Matrix44&);
+        Matrix44(*transpose)(const Matrix44&);
+        Matrix44(*inverse)(const Matrix44&, float);
+        Matrix44(*multiply)(const Matrix44&, const Matrix44&);
     };
-}
 
-const Matrix44 operator *(float k, const Matrix44& m)
-{
-    return m * k;
-}
+    Kernels selectKernels()
+    {
+        Kernels k = { determinantScalar, transposeScalar, inverseScalar, multiplyScalar };
 
-const Matrix44 operator /(const Matrix44& m, float k)
-{
-    check(!equalf(k, 0));
-    const auto invK = 1 / k;
-    return m * invK;
-}
+#ifdef GF_SSE
+        const auto& cpu = cpuFeatures();
+        if (cpu.sse2)
+        {
+            k.determinant = determinantSSE;
+            k.transpose = transposeSSE;
+            k.inverse = inverseSSE;
+            k.multiply = multiplySSE;
+        }
+        if (cpu.avx)
+        {
+            k.multiply = multiplyAVX;
+        }
+#endif
 
-Matrix44& operator +=(Matrix44& a, const Matrix44& b)
-{
-    a = a + b;
-    return a;
+        return k;
+    }
+
+    const Kernels& kernels()
+    {
+        static const Kernels k = selectKernels();
+        return k;
+    }
 }
 
-Matrix44& operator -=(Matrix44& a, const Matrix44& b)
+float Matrix44::determinant() const
 {
-    a = a - b;
-    return a;
+    return kernels().determinant(*this);
 }
 
-Matrix44& operator *=(Matrix44& a, const Matrix44& b)
+Matrix44 Matrix44::transpose() const
 {
-    a = a * b;
-    return a;
+    return kernels().transpose(*this);
 }
 
-Matrix44& operator *=(Matrix44& m, float k)
+Matrix44 Matrix44::inverse() const
 {
-    m = m * k;
-    return m;
+    const auto det = determinant();
+    check(!equalf(det, 0));
+    return kernels().inverse(*this, det);
 }
 
-Matrix44& operator /=(Matrix44& m, float k)
+const Matrix44 operator *(const Matrix44& a, const Matrix44& b)
 {
-    m = m / k;
-    return m;
+    return kernels().multiply(a, b);
 }
 
 Matrix44 makeTransformMatrix(const Vector3& scale, const Quaternion& rot, const Vector3& trans)
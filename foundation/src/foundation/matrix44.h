@@ -2,6 +2,9 @@
 #define GAMEFRIENDS_MATRIX44_H
 
 #include "quaternion.h"
+#include "vector4.h"
+#include "math.h"
+#include "exception.h"
 #include "prerequest.h"
 #include <initializer_list>
 #include <utility>
@@ -9,7 +12,6 @@
 GF_NAMESPACE_BEGIN
 
 class Vector3;
-class Vector4;
 
 class Matrix44
 {
@@ -19,7 +21,7 @@ private:
 public:
     Matrix44() = default;
 
-    Matrix44(
+    constexpr Matrix44(
         float n00, float n01, float n02, float n03,
         float n10, float n11, float n12, float n13,
         float n20, float n21, float n22, float n23,
@@ -40,6 +42,9 @@ public:
     const float& operator ()(size_t r, size_t c) const;
     float& operator ()(size_t r, size_t c);
 
+    const float* data() const; /// Row major 16 floats
+    float* data();
+
     Vector4 row(size_t r) const;
     Vector4 column(size_t c) const;
     float determinant() const;
@@ -74,6 +79,186 @@ Matrix44 makePerspectiveMatrix(float fovY, float aspect, float zn, float zf); //
 Matrix44 makeOrthoMatrix(float width, float height, float zn, float zf);
 Matrix44 makeOrthoMatrix(float left, float right, float bottom, float top, float zn, float zf);
 
+/// Only multiplication, transpose, inverse and determinant stay out of line
+/// because they dispatch to the SIMD kernels.
+constexpr Matrix44::Matrix44(
+    float n00, float n01, float n02, float n03,
+    float n10, float n11, float n12, float n13,
+    float n20, float n21, float n22, float n23,
+    float n30, float n31, float n32, float n33
+    )
+    : m_{
+        { n00, n01, n02, n03 },
+        { n10, n11, n12, n13 },
+        { n20, n21, n22, n23 },
+        { n30, n31, n32, n33 } }
+{
+}
+
+inline Matrix44::Matrix44(std::initializer_list<float> il)
+    : m_()
+{
+    *this = il;
+}
+
+inline void Matrix44::swap(Matrix44& that)
+{
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            std::swap(m_[r][c], that.m_[r][c]);
+        }
+    }
+}
+
+inline Matrix44& Matrix44::operator =(std::initializer_list<float> il)
+{
+    check(il.size() == 16);
+
+    auto it = std::begin(il);
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            m_[r][c] = *it;
+            ++it;
+        }
+    }
+    return *this;
+}
+
+inline const float& Matrix44::operator ()(size_t r, size_t c) const
+{
+    return const_cast<Matrix44&>(*this)(r, c);
+}
+
+inline float& Matrix44::operator ()(size_t r, size_t c)
+{
+    check(r < 4 && c < 4);
+    return m_[r][c];
+}
+
+inline const float* Matrix44::data() const
+{
+    return &m_[0][0];
+}
+
+inline float* Matrix44::data()
+{
+    return &m_[0][0];
+}
+
+inline Vector4 Matrix44::row(size_t r) const
+{
+    return{ m_[r][0], m_[r][1], m_[r][2], m_[r][3] };
+}
+
+inline Vector4 Matrix44::column(size_t c) const
+{
+    return{ m_[0][c], m_[1][c], m_[2][c], m_[3][c] };
+}
+
+inline bool operator ==(const Matrix44& a, const Matrix44& b)
+{
+    return equalf(a(0, 0), b(0, 0)) && equalf(a(0, 1), b(0, 1)) && equalf(a(0, 2), b(0, 2)) && equalf(a(0, 3), b(0, 3))
+        && equalf(a(1, 0), b(1, 0)) && equalf(a(1, 1), b(1, 1)) && equalf(a(1, 2), b(1, 2)) && equalf(a(1, 3), b(1, 3))
+        && equalf(a(2, 0), b(2, 0)) && equalf(a(2, 1), b(2, 1)) && equalf(a(2, 2), b(2, 2)) && equalf(a(2, 3), b(2, 3))
+        && equalf(a(3, 0), b(3, 0)) && equalf(a(3, 1), b(3, 1)) && equalf(a(3, 2), b(3, 2)) && equalf(a(3, 3), b(3, 3));
+}
+
+inline bool operator !=(const Matrix44& a, const Matrix44& b)
+{
+    return !(a == b);
+}
+
+inline const Matrix44 operator +(const Matrix44& m)
+{
+    return m;
+}
+
+inline const Matrix44 operator -(const Matrix44& m)
+{
+    return Matrix44(
+        -m(0, 0), -m(0, 1), -m(0, 2), -m(0, 3),
+        -m(1, 0), -m(1, 1), -m(1, 2), -m(1, 3),
+        -m(2, 0), -m(2, 1), -m(2, 2), -m(2, 3),
+        -m(3, 0), -m(3, 1), -m(3, 2), -m(3, 3)
+        );
+}
+
+inline const Matrix44 operator +(const Matrix44& a, const Matrix44& b)
+{
+    return Matrix44(
+        a(0, 0) + b(0, 0), a(0, 1) + b(0, 1), a(0, 2) + b(0, 2), a(0, 3) + b(0, 3),
+        a(1, 0) + b(1, 0), a(1, 1) + b(1, 1), a(1, 2) + b(1, 2), a(1, 3) + b(1, 3),
+        a(2, 0) + b(2, 0), a(2, 1) + b(2, 1), a(2, 2) + b(2, 2), a(2, 3) + b(2, 3),
+        a(3, 0) + b(3, 0), a(3, 1) + b(3, 1), a(3, 2) + b(3, 2), a(3, 3) + b(3, 3)
+        );
+}
+
+inline const Matrix44 operator -(const Matrix44& a, const Matrix44& b)
+{
+    return Matrix44(
+        a(0, 0) - b(0, 0), a(0, 1) - b(0, 1), a(0, 2) - b(0, 2), a(0, 3) - b(0, 3),
+        a(1, 0) - b(1, 0), a(1, 1) - b(1, 1), a(1, 2) - b(1, 2), a(1, 3) - b(1, 3),
+        a(2, 0) - b(2, 0), a(2, 1) - b(2, 1), a(2, 2) - b(2, 2), a(2, 3) - b(2, 3),
+        a(3, 0) - b(3, 0), a(3, 1) - b(3, 1), a(3, 2) - b(3, 2), a(3, 3) - b(3, 3)
+        );
+}
+
+inline const Matrix44 operator *(const Matrix44& m, float k)
+{
+    return Matrix44(
+        m(0, 0) * k, m(0, 1) * k, m(0, 2) * k, m(0, 3) * k,
+        m(1, 0) * k, m(1, 1) * k, m(1, 2) * k, m(1, 3) * k,
+        m(2, 0) * k, m(2, 1) * k, m(2, 2) * k, m(2, 3) * k,
+        m(3, 0) * k, m(3, 1) * k, m(3, 2) * k, m(3, 3) * k
+        );
+}
+
+inline const Matrix44 operator *(float k, const Matrix44& m)
+{
+    return m * k;
+}
+
+inline const Matrix44 operator /(const Matrix44& m, float k)
+{
+    check(!equalf(k, 0));
+    const auto invK = 1 / k;
+    return m * invK;
+}
+
+inline Matrix44& operator +=(Matrix44& a, const Matrix44& b)
+{
+    a = a + b;
+    return a;
+}
+
+inline Matrix44& operator -=(Matrix44& a, const Matrix44& b)
+{
+    a = a - b;
+    return a;
+}
+
+inline Matrix44& operator *=(Matrix44& a, const Matrix44& b)
+{
+    a = a * b;
+    return a;
+}
+
+inline Matrix44& operator *=(Matrix44& m, float k)
+{
+    m = m * k;
+    return m;
+}
+
+inline Matrix44& operator /=(Matrix44& m, float k)
+{
+    m = m / k;
+    return m;
+}
+
 template <>
 inline Matrix44 to(const Quaternion& q_)
 {
@@ -1,37 +1,39 @@
 #include "metaprop.h"
+#include "metapropbinary.h"
+#include "mappedfile.h"
+#include "jobsystem.h"
 #include "exception.h"
-#include <queue>
 #include <fstream>
+#include <algorithm>
+#include <utility>
 #include <cctype>
+#include <cerrno>
 #include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <atomic>
+#include <mutex>
 
 GF_NAMESPACE_BEGIN
 
 namespace
 {
-    struct Token
+    /// Appends str, quoted if it is empty or has spaces
+    void appendText(std::string& out, StringRef str)
     {
-        std::string token;
-        size_t line;
-    };
-
-    struct Context
-    {
-        std::string path;
-        std::queue<Token> tokens;
-    };
-
-    /*
-    std::string forward(Context& context)
-    {
-        check(!context.tokens.empty());
-
-        const auto poped = context.tokens.front();
-        context.tokens.pop();
-
-        return poped.token;
+        const auto quote = str.empty() || std::any_of(str.begin(), str.end(), [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; });
+        if (quote)
+        {
+            out += '\"';
+        }
+        out.append(str.data(), str.size());
+        if (quote)
+        {
+            out += '\"';
+        }
     }
-    */
 
     std::string inText(const std::string& str)
     {
@@ -50,201 +52,1089 @@ namespace
         return str;
     }
 
-    std::vector<std::string> forwardLine(Context& context)
+    bool isSpace(char c)
     {
-        check(!context.tokens.empty());
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
 
-        std::vector<std::string> tokens;
+    const char* skipSpaces(const char* p, const char* end)
+    {
+        while (p < end && isSpace(*p))
+        {
+            ++p;
+        }
+        return p;
+    }
 
-        const auto line = context.tokens.front().line;
-        while (!context.tokens.empty() && context.tokens.front().line == line)
+    /// Reads the token at p and advances p past it. A quoted token yields the text between the quotes.
+    /// Returns false at the end of the line. Unterminated quotes leave p at the opening quote and set bad.
+    bool nextToken(const char*& p, const char* end, StringRef& token, bool& bad)
+    {
+        p = skipSpaces(p, end);
+        if (p == end)
         {
-            const auto poped = context.tokens.front();
-            context.tokens.pop();
-            tokens.emplace_back(poped.token);
+            return false;
         }
 
-        return tokens;
+        if (*p == '\"')
+        {
+            const auto q = static_cast<const char*>(std::memchr(p + 1, '\"', end - p - 1));
+            if (!q)
+            {
+                bad = true;
+                return false;
+            }
+            token = StringRef(p + 1, q - p - 1);
+            p = q + 1;
+        }
+        else
+        {
+            auto q = p;
+            while (q < end && !isSpace(*q))
+            {
+                ++q;
+            }
+            token = StringRef(p, q - p);
+            p = q;
+        }
+        return true;
     }
 
-    size_t stepByNonspace(size_t p, const std::string& str)
+    /// Calls f(begin, end, lineNumber) for each line with the comment cut off
+    template <class F>
+    void forEachLine(const char* p, const char* end, F f)
     {
-        while (p < str.length() && std::isspace(str[p]))
+        for (size_t line = 1; p < end; ++line)
         {
-            ++p;
+            auto eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!eol)
+            {
+                eol = end;
+            }
+
+            const auto comment = static_cast<const char*>(std::memchr(p, '#', eol - p));
+            f(p, comment ? comment : eol, line);
+            p = eol + 1;
+        }
+    }
+
+    std::string syntaxError(size_t line, const std::string& path)
+    {
+        return "Unexpected systax at line " + std::to_string(line) + " in " + path + ".";
+    }
+
+    enum class LineError
+    {
+        none,
+        syntax,
+        groupName,
+        propertySyntax,
+        propertyName
+    };
+
+    std::string lineErrorMessage(LineError error, StringRef first, size_t line, const std::string& path)
+    {
+        switch (error)
+        {
+        case LineError::syntax: return syntaxError(line, path);
+        case LineError::groupName: return "Invalid group name \"" + first.str() + "\" in " + path + ".";
+        case LineError::propertySyntax: return "Unexpected systax \"" + first.str() + "\" in " + path + ".";
+        default: return "Invalid property name \"" + first.str() + "\" in " + path + ".";
         }
-        return p;
     }
 
-    void tokenizeLine(const std::string& line, size_t currentLine, Context& context)
+    const size_t UNCOUNTED = static_cast<size_t>(-1);
+
+    struct ParsedLine
+    {
+        size_t line;
+        StringRef first;
+        StringRef rest; /// Comment cut off
+        size_t numTokens; /// UNCOUNTED when left to countUnquotedTokens
+    };
+
+    /// Splits a line into its first token and the rest, and checks the syntax. Sets blank for a line without tokens.
+    /// Rests longer than deferAbove without quotes are not counted here.
+    LineError parseLine(const char* p, const char* end, size_t deferAbove, ParsedLine& out, bool& blank)
     {
-        for (size_t p = stepByNonspace(0, line); p < line.length(); p = stepByNonspace(p, line))
+        bool bad = false;
+        blank = !nextToken(p, end, out.first, bad);
+        if (blank)
+        {
+            return bad ? LineError::syntax : LineError::none;
+        }
+
+        out.rest = StringRef(p, end - p);
+        if (out.rest.size() > deferAbove && !std::memchr(p, '\"', end - p))
         {
-            if (line[p] == '\"')
+            out.numTokens = UNCOUNTED;
+        }
+        else
+        {
+            // Counting also rejects unterminated quotes
+            out.numTokens = 0;
+            StringRef token;
+            while (nextToken(p, end, token, bad))
             {
-                const auto q = line.find('\"', p + 1);
-                enforce<InvalidMetaPropFile>(q != std::string::npos, "Unexpected systax at line " + std::to_string(currentLine) + " in " + context.path + ".");
-                if (p + 1 == q)
+                ++out.numTokens;
+            }
+            if (bad)
+            {
+                return LineError::syntax;
+            }
+        }
+
+        const auto& first = out.first;
+        if (!first.empty() && first[0] == '@')
+        {
+            return first.size() > 1 ? LineError::none : LineError::groupName;
+        }
+        if (first.empty() || first[first.size() - 1] != ':')
+        {
+            return LineError::propertySyntax;
+        }
+        return first.size() > 1 ? LineError::none : LineError::propertyName;
+    }
+
+    /// Tokens of text without quotes, counted in chunks on the job system
+    size_t countUnquotedTokens(StringRef text)
+    {
+        const size_t GRAIN = 1 << 18;
+
+        const auto p = text.data();
+        return jobSystem.parallelReduce(0, text.size(), GRAIN, static_cast<size_t>(0),
+            [p](size_t first, size_t last)
+            {
+                // A token starts where a space ends; the chunk edge needs a look at the previous character
+                size_t n = 0;
+                auto prevSpace = first == 0 || isSpace(p[first - 1]);
+                for (auto i = first; i < last; ++i)
                 {
-                    context.tokens.emplace(Token{ "", currentLine });
+                    const auto space = isSpace(p[i]);
+                    n += prevSpace && !space;
+                    prevSpace = space;
                 }
-                else
+                return n;
+            },
+            [](size_t a, size_t b) { return a + b; });
+    }
+
+    std::string invalidNumber(const std::string& name, StringRef value, size_t line)
+    {
+        return "Invalid number \"" + value.str() + "\" in " + name + (line > 0 ? " at line " + std::to_string(line) : std::string()) + ".";
+    }
+
+    bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    /// Powers of ten exactly representable as double
+    const double EXACT_POW10[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    /// mantissa * 10^exponent rounded to float, if one double multiply or divide gets it exactly.
+    /// That is mantissas up to 2^53 with exponents within +-22, unless the double lands on the midpoint of two floats:
+    /// only there could rounding to double first have moved the value across it.
+    bool decimalToFloat(uint64 mantissa, int exponent, float& out)
+    {
+        if (mantissa > (static_cast<uint64>(1) << 53) || exponent < -22 || exponent > 22)
+        {
+            return false;
+        }
+
+        auto d = static_cast<double>(mantissa);
+        d = exponent < 0 ? d / EXACT_POW10[-exponent] : d * EXACT_POW10[exponent];
+
+        // Normal floats drop the low 29 of the 52 fraction bits of a double; a midpoint drops exactly one half
+        const uint64 DROPPED = (static_cast<uint64>(1) << 29) - 1;
+        uint64 bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        if ((bits & DROPPED) == (static_cast<uint64>(1) << 28))
+        {
+            return false;
+        }
+
+        out = static_cast<float>(d);
+        return true;
+    }
+
+    /// [+-]digits[.digits][(e|E)[+-]digits] with at least one digit in the mantissa, or [+-]inf and [+-]nan as formatFloat writes them.
+    /// Short decimals go through decimalToFloat, anything else through strtof.
+    bool parseFloat(StringRef value, float& out)
+    {
+        auto p = value.begin();
+        const auto end = value.end();
+
+        const auto negative = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            ++p;
+        }
+
+        const StringRef word(p, end - p);
+        if (word == "inf" || word == "nan")
+        {
+            out = word == "inf" ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+            out = negative ? -out : out;
+            return true;
+        }
+
+        uint64 mantissa = 0;
+        int numDigits = 0; /// Significant digits in mantissa
+        int exponent = 0;
+        bool anyDigit = false;
+        bool truncated = false;
+
+        const auto addDigit = [&](char c)
+        {
+            anyDigit = true;
+            if (numDigits < 19)
+            {
+                mantissa = mantissa * 10 + (c - '0');
+                numDigits += mantissa > 0;
+                return true;
+            }
+            truncated = truncated || c != '0';
+            return false;
+        };
+
+        for (; p < end && isDigit(*p); ++p)
+        {
+            exponent += addDigit(*p) ? 0 : 1;
+        }
+        if (p < end && *p == '.')
+        {
+            for (++p; p < end && isDigit(*p); ++p)
+            {
+                exponent -= addDigit(*p) ? 1 : 0;
+            }
+        }
+        if (!anyDigit)
+        {
+            return false;
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            const auto negativeExp = p < end && *p == '-';
+            if (p < end && (*p == '-' || *p == '+'))
+            {
+                ++p;
+            }
+            if (p == end || !isDigit(*p))
+            {
+                return false;
+            }
+
+            int e = 0;
+            for (; p < end && isDigit(*p); ++p)
+            {
+                e = std::min(e * 10 + (*p - '0'), 100000);
+            }
+            exponent += negativeExp ? -e : e;
+        }
+        if (p != end)
+        {
+            return false;
+        }
+
+        if (!truncated && decimalToFloat(mantissa, exponent, out))
+        {
+            out = negative ? -out : out;
+            return true;
+        }
+
+        // strtof needs a terminated copy. Too large values are rejected as stof does;
+        // unlike stof, subnormals are kept since they are floats too.
+        const std::string s = value.str();
+        errno = 0;
+        out = std::strtof(s.c_str(), nullptr);
+        return errno != ERANGE || std::fabs(out) != std::numeric_limits<float>::infinity();
+    }
+
+    /// Writes digits * 10^exponent as printf's %g does, without a terminator. Returns the end.
+    char* formatDecimal(uint64 digits, int exponent, char* out)
+    {
+        while (digits >= 10 && digits % 10 == 0)
+        {
+            digits /= 10;
+            ++exponent;
+        }
+
+        char buf[20];
+        int numDigits = 0;
+        for (; digits > 0 || numDigits == 0; digits /= 10)
+        {
+            buf[numDigits++] = static_cast<char>('0' + digits % 10);
+        }
+        std::reverse(buf, buf + numDigits);
+
+        // Exponent of the first digit
+        const auto point = numDigits - 1 + exponent;
+        if (point < -4 || point >= 9)
+        {
+            *out++ = buf[0];
+            if (numDigits > 1)
+            {
+                *out++ = '.';
+                out = std::copy(buf + 1, buf + numDigits, out);
+            }
+            *out++ = 'e';
+            *out++ = point < 0 ? '-' : '+';
+            const auto e = point < 0 ? -point : point;
+            if (e >= 100)
+            {
+                *out++ = static_cast<char>('0' + e / 100);
+            }
+            *out++ = static_cast<char>('0' + e / 10 % 10);
+            *out++ = static_cast<char>('0' + e % 10);
+        }
+        else if (point < 0)
+        {
+            *out++ = '0';
+            *out++ = '.';
+            out = std::fill_n(out, -point - 1, '0');
+            out = std::copy(buf, buf + numDigits, out);
+        }
+        else
+        {
+            const auto numInteger = std::min(numDigits, point + 1);
+            out = std::copy(buf, buf + numInteger, out);
+            out = std::fill_n(out, point + 1 - numInteger, '0');
+            if (numDigits > numInteger)
+            {
+                *out++ = '.';
+                out = std::copy(buf + numInteger, buf + numDigits, out);
+            }
+        }
+        return out;
+    }
+
+    /// Values each followed by a space
+    template <class T>
+    std::string formatUnsigned(const T* values, size_t n)
+    {
+        std::string text;
+        text.reserve(n * 6);
+
+        char buf[16];
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto p = std::end(buf);
+            auto value = values[i];
+            do
+            {
+                *--p = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value > 0);
+            text.append(p, std::end(buf));
+            text += ' ';
+        }
+        return text;
+    }
+}
+
+namespace detail
+{
+    char* formatFloat(float value, char* out)
+    {
+        if (value != value)
+        {
+            return std::copy_n("nan", 3, out);
+        }
+        if (std::signbit(value))
+        {
+            *out++ = '-';
+            value = -value;
+        }
+        if (value == std::numeric_limits<float>::infinity())
+        {
+            return std::copy_n("inf", 3, out);
+        }
+        if (value == 0)
+        {
+            *out++ = '0';
+            return out;
+        }
+
+        // Round to n significant digits in double, which holds every float exactly. A value that reads back with n digits
+        // does with n + 1 too, so the fewest are found by bisection. The scale needs to be one exact power of ten.
+        const double d = value;
+        auto point = static_cast<int>(std::floor(std::log10(d)));
+        if (point >= -13 && point <= 22)
+        {
+            // log10 may round up just below a power of ten
+            if (point >= 0 ? d < EXACT_POW10[point] : d * EXACT_POW10[-point] < 1)
+            {
+                --point;
+            }
+
+            const auto readsBack = [&](int numDigits, uint64& digits, int& exponent)
+            {
+                const auto scale = numDigits - 1 - point;
+                digits = static_cast<uint64>((scale < 0 ? d / EXACT_POW10[-scale] : d * EXACT_POW10[scale]) + 0.5);
+                exponent = -scale;
+
+                float back;
+                if (decimalToFloat(digits, exponent, back))
                 {
-                    context.tokens.emplace(Token{ line.substr(p + 1, q - p - 1), currentLine });
+                    return back == value;
                 }
-                p = q + 1;
-            }
-            else
+
+                // A tie between two floats, only strtof knows which way it goes
+                char buf[32];
+                const auto end = formatDecimal(digits, exponent, buf);
+                return parseFloat(StringRef(buf, end - buf), back) && back == value;
+            };
+
+            uint64 digits;
+            int exponent;
+            if (readsBack(9, digits, exponent))
             {
-                auto q = p;
-                while (q < line.length() && !std::isspace(line[q]))
+                int fewest = 1;
+                int most = 9;
+                while (fewest < most)
                 {
-                    ++q;
+                    const auto numDigits = (fewest + most) / 2;
+                    uint64 fewerDigits;
+                    int fewerExponent;
+                    if (readsBack(numDigits, fewerDigits, fewerExponent))
+                    {
+                        most = numDigits;
+                        digits = fewerDigits;
+                        exponent = fewerExponent;
+                    }
+                    else
+                    {
+                        fewest = numDigits + 1;
+                    }
                 }
-                context.tokens.emplace(Token{ line.substr(p, q - p), currentLine });
-                p = q + 1;
+                return formatDecimal(digits, exponent, out);
+            }
+        }
+
+        // Tiny, huge or unlucky values, 9 digits always read back
+        char buf[32];
+        for (int precision = 1; precision <= 9; ++precision)
+        {
+            const auto n = std::snprintf(buf, sizeof(buf), "%.*g", precision, value);
+            float back;
+            if (precision == 9 || (parseFloat(StringRef(buf, n), back) && back == value))
+            {
+                return std::copy(buf, buf + n, out);
+            }
+        }
+        return out;
+    }
+}
+
+namespace
+{
+    /// [+]digits not greater than max
+    bool parseUnsigned(StringRef value, uint32 max, uint32& out)
+    {
+        auto p = value.begin();
+        const auto end = value.end();
+        if (p < end && *p == '+')
+        {
+            ++p;
+        }
+        if (p == end)
+        {
+            return false;
+        }
+
+        uint64 n = 0;
+        for (; p < end; ++p)
+        {
+            if (!isDigit(*p))
+            {
+                return false;
+            }
+            n = n * 10 + (*p - '0');
+            if (n > max)
+            {
+                return false;
             }
         }
+        out = static_cast<uint32>(n);
+        return true;
     }
 
-    void tokenize(std::ifstream& stream, Context& context)
+    /// The fewest significant digits that std::stod reads back as value, 17 always do.
+    /// %g switches to an exponent below the number of integer digits, so at least those are written.
+    std::string formatDouble(double value)
     {
-        size_t n = 0;
-        while (!stream.eof())
+        if (value != value)
+        {
+            return "nan";
+        }
+
+        int precision = 1;
+        for (auto magnitude = std::fabs(value); precision < 17 && magnitude >= 10; magnitude /= 10)
+        {
+            ++precision;
+        }
+
+        char buf[32];
+        for (;; ++precision)
         {
-            ++n;
-            std::string line;
-            std::getline(stream, line);
-            line = line.substr(0, line.find("#"));
-            tokenizeLine(line, n, context);
+            const auto n = std::snprintf(buf, sizeof(buf), "%.*g", precision, value);
+            if (precision >= 17 || std::strtod(buf, nullptr) == value)
+            {
+                return std::string(buf, n);
+            }
         }
     }
 }
 
+namespace
+{
+    /// Builds a MetaPropFile from the events of MetaPropFile::stream
+    class MetaPropBuilder : public MetaPropHandler
+    {
+    private:
+        MetaPropFile& file_;
+        MetaPropGroup group_;
+
+    public:
+        explicit MetaPropBuilder(MetaPropFile& file)
+            : file_(file)
+            , group_()
+        {
+        }
+
+        void beginGroup(StringRef name) override
+        {
+            group_ = MetaPropGroup(name.str());
+        }
+
+        void endGroup(StringRef name) override
+        {
+            if (name == "_Header")
+            {
+                file_.setAuther(group_.get("Auther")[0]);
+                file_.setComment(group_.get("Comment")[0]);
+            }
+            else
+            {
+                file_.add(std::move(group_));
+            }
+        }
+
+        void property(const MetaProperty& prop) override
+        {
+            group_.add(prop);
+        }
+    };
+
+    /// Collects the properties of one group parsed on its own
+    class GroupBuilder : public MetaPropHandler
+    {
+    private:
+        MetaPropGroup& group_;
+
+    public:
+        explicit GroupBuilder(MetaPropGroup& group)
+            : group_(group)
+        {
+        }
+
+        void beginGroup(StringRef) override {}
+        void endGroup(StringRef) override {}
+
+        void property(const MetaProperty& prop) override
+        {
+            group_.add(prop);
+        }
+    };
+}
+
+struct MetaPropFile::GroupIndex
+{
+    struct Group
+    {
+        StringRef text; /// From the group line to the next group line
+        size_t firstLine;
+        std::atomic<bool> parsed;
+        std::mutex mutex;
+        MetaPropGroup group;
+    };
+
+    std::string path;
+    std::shared_ptr<const MappedFile> source;
+    HashMap<std::string, std::unique_ptr<Group>> groups;
+};
+
 void MetaPropFile::read(const std::string& path)
 {
     *this = MetaPropFile();
 
-    std::ifstream stream(path);
-    enforce<FileException>(stream.is_open(), "Failed to open file (" + path + ").");
+    // Properties refer to the mapped text, keep it in memory
+    MetaPropBuilder builder(*this);
+    parse(path, builder, false, false);
+}
 
-    Context context = {};
-    context.path = path;
-    tokenize(stream, context);
-    stream.close();
+void MetaPropFile::readParallel(const std::string& path)
+{
+    *this = MetaPropFile();
+
+    MetaPropBuilder builder(*this);
+    parse(path, builder, false, true);
+}
+
+void MetaPropFile::readIndexed(const std::string& path)
+{
+    *this = MetaPropFile();
 
-    MetaPropGroup currentGroup;
+    const auto index = std::make_shared<GroupIndex>();
+    index->path = path;
+    index->source = std::make_shared<MappedFile>(path);
+    const auto& source = index->source;
+    const auto begin = source->data();
+    const auto end = begin + source->size();
+
+    // Lines before the first group and _Header are parsed now, as read() does
+    MetaPropBuilder builder(*this);
+    const char* groupBegin = begin;
+    size_t groupLine = 0;
+    std::string groupName;
     bool groupNow = false;
 
-    while (!context.tokens.empty())
+    const auto endGroup = [&](const char* groupEnd)
+    {
+        const StringRef text(groupBegin, groupEnd - groupBegin);
+        if (!groupNow || groupName == "_Header")
+        {
+            parse(source, text, groupLine, path, builder, false, false);
+        }
+        else
+        {
+            // The last group of a name wins, as with add()
+            std::unique_ptr<GroupIndex::Group> group(new GroupIndex::Group());
+            group->text = text;
+            group->firstLine = groupLine;
+            group->parsed = false;
+            index->groups[groupName] = std::move(group);
+        }
+    };
+
+    forEachLine(begin, end, [&](const char* p, const char* lineEnd, size_t line)
     {
-        const auto tokens = forwardLine(context);
+        // Only group lines are checked now, other lines when their group is parsed
+        const auto q = skipSpaces(p, lineEnd);
+        if (q == lineEnd || (*q != '@' && *q != '\"'))
+        {
+            return;
+        }
+
+        ParsedLine parsed;
+        bool blank;
+        const auto error = parseLine(p, lineEnd, UNCOUNTED, parsed, blank);
+        if (blank || parsed.first.empty() || parsed.first[0] != '@')
+        {
+            return;
+        }
+        if (error != LineError::none)
+        {
+            throw InvalidMetaPropFile(lineErrorMessage(error, parsed.first, line, path));
+        }
+
+        endGroup(p);
+        groupBegin = p;
+        groupLine = line - 1;
+        groupName = StringRef(parsed.first.data() + 1, parsed.first.size() - 1).str();
+        groupNow = true;
+    });
+    endGroup(end);
+
+    index_ = index;
+}
+
+void MetaPropFile::stream(const std::string& path, MetaPropHandler& handler)
+{
+    parse(path, handler, true, false);
+}
+
+void MetaPropFile::parse(const std::string& path, MetaPropHandler& handler, bool releaseParsed, bool parallel)
+{
+    const std::shared_ptr<const MappedFile> source = std::make_shared<MappedFile>(path);
+    parse(source, source->str(), 0, path, handler, releaseParsed, parallel);
+}
+
+void MetaPropFile::parse(const std::shared_ptr<const MappedFile>& source, StringRef text, size_t firstLine,
+    const std::string& path, MetaPropHandler& handler, bool releaseParsed, bool parallel)
+{
+    // Smaller files are not worth the jobs
+    const size_t PARALLEL_MIN_SIZE = 1 << 20;
+    const size_t CHUNKS_PER_THREAD = 4;
+
+    // Releasing is a system call, batch it
+    const size_t RELEASE_GRANULARITY = 1 << 20;
 
-        if (tokens[0].front() == '@')
+    const auto begin = text.begin();
+    const auto end = text.end();
+
+    StringRef groupName;
+    bool groupNow = false;
+
+    const auto emit = [&](const ParsedLine& parsed)
+    {
+        const auto& first = parsed.first;
+        if (first[0] == '@')
         {
-            // Add current group
+            // End current group, then begin new group
             if (groupNow)
             {
-                if (currentGroup.name() == "_Header")
-                {
-                    auther_ = currentGroup.get("Auther")[0];
-                    comment_ = currentGroup.get("Comment")[0];
-                }
-                else
-                {
-                    add(currentGroup);
-                }
+                handler.endGroup(groupName);
             }
-
-            // Create new current group
-            const auto groupName = tokens[0];
-            enforce<InvalidMetaPropFile>(groupName.length() > 1, "Invalid group name \"" + groupName + "\" in " + context.path + ".");
-
-            currentGroup = MetaPropGroup();
-            currentGroup.setName(groupName.substr(1));
+            groupName = StringRef(first.data() + 1, first.size() - 1);
             groupNow = true;
+            handler.beginGroup(groupName);
         }
         else
         {
-            // New property
-            enforce<InvalidMetaPropFile>(tokens[0].back() == ':', "Unexpected systax \"" +  tokens[0] + "\" in " + context.path + ".");
+            const auto numTokens = parsed.numTokens == UNCOUNTED ? countUnquotedTokens(parsed.rest) : parsed.numTokens;
+            handler.property(MetaProperty(StringRef(first.data(), first.size() - 1), parsed.rest, numTokens, parsed.line, source));
+        }
+    };
+
+    const auto numThreads = jobSystem.numThreads();
+    if (parallel && numThreads > 1 && text.size() >= PARALLEL_MIN_SIZE)
+    {
+        // Quotes and comments end with the line, so chunks split after a newline parse independently.
+        // Lines longer than a chunk are split again when their tokens are counted.
+        struct Chunk
+        {
+            const char* begin;
+            const char* end;
+            std::vector<ParsedLine> lines;
+            size_t numLines;
+            LineError error;
+            StringRef errorFirst;
+            size_t errorLine;
+        };
 
-            const auto propName = tokens[0];
-            enforce<InvalidMetaPropFile>(propName.length() > 1, "Invalid property name \"" + propName + "\" in " + context.path + ".");
+        const auto numChunks = numThreads * CHUNKS_PER_THREAD;
+        const auto chunkSize = text.size() / numChunks;
+        std::vector<Chunk> chunks;
+        for (auto p = begin; p < end; )
+        {
+            auto q = p + std::min(chunkSize, static_cast<size_t>(end - p));
+            const auto eol = q < end ? static_cast<const char*>(std::memchr(q, '\n', end - q)) : nullptr;
+            q = eol ? eol + 1 : end;
 
-            MetaProperty prop;
-            prop.setName(propName.substr(0, propName.length() - 1));
+            chunks.emplace_back();
+            chunks.back().begin = p;
+            chunks.back().end = q;
+            p = q;
+        }
 
-            const auto n = tokens.size() - 1;
-            for (size_t i = 0; i < n; ++i)
+        jobSystem.parallelFor(0, chunks.size(), 1, [&](size_t firstChunk, size_t lastChunk)
+        {
+            for (auto c = firstChunk; c < lastChunk; ++c)
             {
-                prop[i] = tokens[i + 1];
+                auto& chunk = chunks[c];
+                chunk.numLines = 0;
+                chunk.error = LineError::none;
+                forEachLine(chunk.begin, chunk.end, [&](const char* p, const char* lineEnd, size_t line)
+                {
+                    if (chunk.error != LineError::none)
+                    {
+                        return;
+                    }
+
+                    chunk.numLines = line;
+                    ParsedLine parsed;
+                    bool blank;
+                    const auto error = parseLine(p, lineEnd, chunkSize, parsed, blank);
+                    if (error != LineError::none)
+                    {
+                        chunk.error = error;
+                        chunk.errorFirst = parsed.first;
+                        chunk.errorLine = line;
+                    }
+                    else if (!blank)
+                    {
+                        parsed.line = line;
+                        chunk.lines.emplace_back(parsed);
+                    }
+                });
             }
+        });
 
-            currentGroup.add(prop);
+        // Stitch in file order; the first error is the one a sequential parse meets
+        auto linesBefore = firstLine;
+        for (const auto& chunk : chunks)
+        {
+            if (chunk.error != LineError::none)
+            {
+                throw InvalidMetaPropFile(lineErrorMessage(chunk.error, chunk.errorFirst, linesBefore + chunk.errorLine, path));
+            }
+            linesBefore += chunk.numLines;
+        }
+
+        linesBefore = firstLine;
+        for (auto& chunk : chunks)
+        {
+            for (auto& parsed : chunk.lines)
+            {
+                parsed.line += linesBefore;
+                emit(parsed);
+            }
+            linesBefore += chunk.numLines;
         }
     }
+    else
+    {
+        auto released = static_cast<size_t>(begin - source->data());
+        forEachLine(begin, end, [&](const char* p, const char* lineEnd, size_t line)
+        {
+            ParsedLine parsed;
+            bool blank;
+            const auto error = parseLine(p, lineEnd, UNCOUNTED, parsed, blank);
+            if (error != LineError::none)
+            {
+                throw InvalidMetaPropFile(lineErrorMessage(error, parsed.first, firstLine + line, path));
+            }
+            if (!blank)
+            {
+                parsed.line = firstLine + line;
+                emit(parsed);
+            }
+
+            const auto parsedSize = static_cast<size_t>(lineEnd - source->data());
+            if (releaseParsed && parsedSize - released >= RELEASE_GRANULARITY)
+            {
+                source->release(released, parsedSize - released);
+                released = parsedSize;
+            }
+        });
+    }
 
-    // Add current group
     if (groupNow)
     {
-        if (currentGroup.name() == "_Header")
-        {
-            auther_ = currentGroup.get("Auther")[0];
-            comment_ = currentGroup.get("Comment")[0];
-        }
-        else
+        handler.endGroup(groupName);
+    }
+}
+
+template <class F>
+void MetaPropFile::forEachGroup(F f) const
+{
+    for (const auto& g : groupTable_)
+    {
+        f(g.second);
+    }
+    if (index_)
+    {
+        for (const auto& g : index_->groups)
         {
-            add(currentGroup);
+            if (!groupTable_.contains(g.first))
+            {
+                f(*findIndexed(g.first));
+            }
         }
     }
 }
 
 void MetaPropFile::write(const std::string& path)
 {
+    const size_t BLOCK_SIZE = 1 << 20;
+
     std::ofstream stream(path, std::ios_base::out | std::ios_base::trunc);
     enforce<FileException>(stream.is_open(), "Failed open file (" + path + ").");
 
-    stream << "@_Header\nAuther: " + inText(auther_) + "\nComment: " + inText(comment_) + "\n";
-    for (const auto& g : groupTable_)
+    std::vector<const MetaPropGroup*> groups;
+    forEachGroup([&](const MetaPropGroup& group)
+    {
+        groups.emplace_back(&group);
+    });
+    std::sort(groups.begin(), groups.end(), [](const MetaPropGroup* a, const MetaPropGroup* b) { return a->name_ < b->name_; });
+
+    std::string buffer;
+    buffer.reserve(BLOCK_SIZE * 2);
+    const auto flush = [&](size_t atLeast)
+    {
+        if (buffer.size() >= atLeast)
+        {
+            stream.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    };
+
+    buffer += "@_Header\nAuther: " + inText(auther_) + "\nComment: " + inText(comment_) + "\n";
+    for (const auto g : groups)
     {
-        stream << "\n";
-        stream << g.second.asString();
+        buffer += "\n@";
+        appendText(buffer, g->name_);
+        for (const auto p : g->sortedProperties())
+        {
+            buffer += '\n';
+            p->appendTo(buffer);
+            flush(BLOCK_SIZE);
+        }
+        buffer += '\n';
     }
+    flush(0);
 
     stream.close();
+    enforce<FileException>(!stream.fail(), "Failed to write file (" + path + ").");
+}
+
+void MetaPropFile::writeBinary(const std::string& path)
+{
+    BinaryMetaPropWriter writer;
+    writer.setAuther(auther_);
+    writer.setComment(comment_);
+    forEachGroup([&](const MetaPropGroup& group)
+    {
+        writer.beginGroup(group.name_);
+        for (const auto& p : group.propTable_)
+        {
+            writer.add(p.second);
+        }
+    });
+    writer.write(path);
 }
 
 std::string MetaPropGroup::asString() const
 {
     std::string asString;
     asString += "@" + inText(name_);
-    for (const auto p : propTable_)
+    for (const auto p : sortedProperties())
     {
         asString += "\n";
-        asString += p.second.asString();
+        p->appendTo(asString);
     }
     asString += "\n";
     return asString;
 }
 
+std::vector<const MetaProperty*> MetaPropGroup::sortedProperties() const
+{
+    std::vector<const MetaProperty*> props;
+    props.reserve(propTable_.size());
+    for (const auto& p : propTable_)
+    {
+        props.emplace_back(&p.second);
+    }
+    std::sort(props.begin(), props.end(), [](const MetaProperty* a, const MetaProperty* b) { return a->name_ < b->name_; });
+    return props;
+}
+
 std::string MetaProperty::asString() const
 {
     std::string asString;
+    appendTo(asString);
+    return asString;
+}
 
-    asString += inText(name_) + ":";
-    for (const auto& v : values_)
+void MetaProperty::appendTo(std::string& out) const
+{
+    appendText(out, name_);
+    out += ':';
+
+    if (!owned_ && (text_.empty() || !std::memchr(text_.data(), '\"', text_.size())))
     {
-        asString += " ";
-        asString += inText(v);
+        // Without quotes values are the runs of non-space characters, copy them one space apart
+        const auto start = out.size();
+        out.resize(start + text_.size() + 1);
+        auto q = &out[start];
+        bool space = true;
+        for (const auto c : text_)
+        {
+            if (isSpace(c))
+            {
+                space = true;
+                continue;
+            }
+            if (space)
+            {
+                *q++ = ' ';
+                space = false;
+            }
+            *q++ = c;
+        }
+        out.resize(q - out.data());
+        return;
     }
-    return asString;
+
+    forEachValue(size(), [&](size_t, StringRef value)
+    {
+        out += ' ';
+        appendText(out, value);
+    });
+}
+
+MetaProperty::MetaProperty()
+    : MetaProperty(std::string())
+{
 }
 
 MetaProperty::MetaProperty(const std::string& name)
     : name_(name)
+    , source_()
+    , text_()
+    , numTokens_(0)
+    , line_(0)
+    , tokens_()
+    , values_()
+    , owned_(true)
+{
+}
+
+MetaProperty::MetaProperty(StringRef name, StringRef text, size_t numTokens, size_t line,
+    const std::shared_ptr<const MappedFile>& source)
+    : name_(name.str())
+    , source_(source)
+    , text_(text)
+    , numTokens_(numTokens)
+    , line_(line)
+    , tokens_()
     , values_()
+    , owned_(false)
+{
+}
+
+const std::vector<StringRef>& MetaProperty::tokens() const
+{
+    check(!owned_);
+    if (tokens_.size() != numTokens_)
+    {
+        tokens_.clear();
+        tokens_.reserve(numTokens_);
+
+        auto p = text_.begin();
+        bool bad = false;
+        StringRef token;
+        while (nextToken(p, text_.end(), token, bad))
+        {
+            tokens_.emplace_back(token);
+        }
+        check(!bad && tokens_.size() == numTokens_);
+    }
+    return tokens_;
+}
+
+void MetaProperty::own() const
 {
+    if (!owned_)
+    {
+        const auto& tokens = this->tokens();
+        values_.reserve(tokens.size());
+        for (const auto& t : tokens)
+        {
+            values_.emplace_back(t.str());
+        }
+
+        tokens_ = std::vector<StringRef>();
+        owned_ = true;
+    }
 }
 
 void MetaProperty::setName(const std::string& name)
@@ -259,13 +1149,23 @@ std::string MetaProperty::name() const
 
 size_t MetaProperty::size() const
 {
-    return values_.size();
+    return owned_ ? values_.size() : numTokens_;
+}
+
+size_t MetaProperty::line() const
+{
+    return line_;
+}
+
+StringRef MetaProperty::text() const
+{
+    return text_;
 }
 
 std::string MetaProperty::get(size_t i) const
 {
-    check(i < values_.size());
-    return values_[i];
+    check(i < size());
+    return owned_ ? values_[i] : tokens()[i].str();
 }
 
 int MetaProperty::stoi(size_t i) const
@@ -308,8 +1208,120 @@ long double MetaProperty::stold(size_t i) const
     return std::stoi(get(i));
 }
 
+template <class F>
+size_t MetaProperty::forEachValue(size_t n, F f) const
+{
+    n = std::min(n, size());
+    if (owned_)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            f(i, StringRef(values_[i]));
+        }
+        return n;
+    }
+
+    auto p = text_.begin();
+    bool bad = false;
+    StringRef token;
+    for (size_t i = 0; i < n && nextToken(p, text_.end(), token, bad); ++i)
+    {
+        f(i, token);
+    }
+    return n;
+}
+
+size_t MetaProperty::parse(float* out, size_t n) const
+{
+    return forEachValue(n, [&](size_t i, StringRef value)
+    {
+        if (!parseFloat(value, out[i]))
+        {
+            throw InvalidMetaPropFile(invalidNumber(name_, value, line_));
+        }
+    });
+}
+
+size_t MetaProperty::parse(uint16* out, size_t n) const
+{
+    return forEachValue(n, [&](size_t i, StringRef value)
+    {
+        uint32 u;
+        if (!parseUnsigned(value, 0xffff, u))
+        {
+            throw InvalidMetaPropFile(invalidNumber(name_, value, line_));
+        }
+        out[i] = static_cast<uint16>(u);
+    });
+}
+
+size_t MetaProperty::parse(uint32* out, size_t n) const
+{
+    return forEachValue(n, [&](size_t i, StringRef value)
+    {
+        if (!parseUnsigned(value, 0xffffffff, out[i]))
+        {
+            throw InvalidMetaPropFile(invalidNumber(name_, value, line_));
+        }
+    });
+}
+
+void MetaProperty::set(size_t i, float val)
+{
+    char buf[32];
+    this->operator[](i).assign(buf, detail::formatFloat(val, buf));
+}
+
+void MetaProperty::set(size_t i, double val)
+{
+    this->operator[](i) = formatDouble(val);
+}
+
+void MetaProperty::setArray(const float* values, size_t n)
+{
+    std::string text;
+    text.reserve(n * 10);
+
+    char buf[32];
+    for (size_t i = 0; i < n; ++i)
+    {
+        text.append(buf, detail::formatFloat(values[i], buf));
+        text += ' ';
+    }
+    setText(std::move(text), n);
+}
+
+void MetaProperty::setArray(const uint16* values, size_t n)
+{
+    setText(formatUnsigned(values, n), n);
+}
+
+void MetaProperty::setArray(const uint32* values, size_t n)
+{
+    setText(formatUnsigned(values, n), n);
+}
+
+void MetaProperty::setText(std::string&& text, size_t numTokens)
+{
+    // Drop the separator after the last value
+    if (!text.empty())
+    {
+        text.pop_back();
+    }
+
+    const auto source = std::make_shared<const std::string>(std::move(text));
+    source_ = source;
+    text_ = StringRef(*source);
+    numTokens_ = numTokens;
+    line_ = 0;
+    tokens_ = std::vector<StringRef>();
+    values_ = std::vector<std::string>();
+    owned_ = false;
+}
+
 const std::string& MetaProperty::operator [](size_t i) const
 {
+    own();
     if (i >= values_.size())
     {
         values_.resize(i + 1);
@@ -338,9 +1350,9 @@ std::string MetaPropGroup::name() const
     return name_;
 }
 
-bool MetaPropGroup::has(const std::string& name) const
+bool MetaPropGroup::has(StringRef name) const
 {
-    return propTable_.find(name) != std::cend(propTable_);
+    return propTable_.contains(name);
 }
 
 void MetaPropGroup::add(const MetaProperty& prop)
@@ -348,10 +1360,15 @@ void MetaPropGroup::add(const MetaProperty& prop)
     propTable_.emplace(prop.name(), prop);
 }
 
-const MetaProperty& MetaPropGroup::get(const std::string& name) const
+void MetaPropGroup::add(MetaProperty&& prop)
 {
-    check(has(name));
-    return propTable_.find(name)->second;
+    auto name = prop.name();
+    propTable_.emplace(std::move(name), std::move(prop));
+}
+
+const MetaProperty& MetaPropGroup::get(StringRef name) const
+{
+    return propTable_.at(name);
 }
 
 std::string MetaPropFile::auther() const
@@ -374,9 +1391,9 @@ void MetaPropFile::setComment(const std::string& comment)
     comment_ = comment;
 }
 
-bool MetaPropFile::has(const std::string& name) const
+bool MetaPropFile::has(StringRef name) const
 {
-    return groupTable_.find(name) != std::cend(groupTable_);
+    return groupTable_.contains(name) || (index_ && index_->groups.contains(name));
 }
 
 void MetaPropFile::add(const MetaPropGroup& group)
@@ -384,10 +1401,54 @@ void MetaPropFile::add(const MetaPropGroup& group)
     groupTable_[group.name()] = group;
 }
 
-const MetaPropGroup& MetaPropFile::get(const std::string& name) const
+void MetaPropFile::add(MetaPropGroup&& group)
+{
+    auto name = group.name();
+    groupTable_[std::move(name)] = std::move(group);
+}
+
+const MetaPropGroup& MetaPropFile::get(StringRef name) const
+{
+    // Added groups take the place of indexed ones like a later group of the file does
+    if (index_ && !groupTable_.contains(name))
+    {
+        if (const auto group = findIndexed(name))
+        {
+            return *group;
+        }
+    }
+    return groupTable_.at(name);
+}
+
+const MetaPropGroup* MetaPropFile::findIndexed(StringRef name) const
 {
-    check(has(name));
-    return groupTable_.find(name)->second;
+    const auto it = index_->groups.find(name);
+    if (it == index_->groups.end())
+    {
+        return nullptr;
+    }
+
+    auto& group = *it->second;
+    if (!group.parsed.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(group.mutex);
+        if (!group.parsed.load(std::memory_order_relaxed))
+        {
+            // Left unparsed if this throws, the next get() throws again
+            MetaPropGroup parsed(it->first);
+            GroupBuilder builder(parsed);
+            parse(index_->source, group.text, group.firstLine, index_->path, builder, false, false);
+
+            // Split now, under the lock, so get() on a shared property only reads
+            for (const auto& prop : parsed.propTable_)
+            {
+                prop.second.tokens();
+            }
+            group.group = std::move(parsed);
+            group.parsed.store(true, std::memory_order_release);
+        }
+    }
+    return &group.group;
 }
 
 GF_NAMESPACE_END
\ No newline at end of file
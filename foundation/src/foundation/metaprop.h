@@ -3,9 +3,11 @@
 
 #include "prerequest.h"
 #include "exception.h"
+#include "hashmap.h"
+#include "stringref.h"
 #include <string>
-#include <unordered_map>
 #include <vector>
+#include <memory>
 
 GF_NAMESPACE_BEGIN
 
@@ -16,20 +18,45 @@ public:
         : FileException(msg) {}
 };
 
+class MappedFile;
+
+namespace detail
+{
+    /// Writes the shortest of the correctly rounded decimals that MetaProperty parses back as value, without a terminator.
+    /// Returns the end; at most 16 characters are written.
+    char* formatFloat(float value, char* out);
+}
+
+/// Values of a property read from a file stay as spans over the mapped file until a std::string is asked for.
 class MetaProperty
 {
 private:
+    friend class MetaPropFile;
+    friend class MetaPropGroup;
+
     std::string name_;
+
+    std::shared_ptr<const void> source_; /// Keeps text_ alive, the mapped file or the text of setArray()
+    StringRef text_; /// Values as written, comment stripped
+    size_t numTokens_;
+    size_t line_;
+    mutable std::vector<StringRef> tokens_; /// Split from text_ on first indexed access
+
     mutable std::vector<std::string> values_;
+    mutable bool owned_; /// values_ holds the values, tokens are stale
 
 public:
-    MetaProperty() = default;
+    MetaProperty();
     explicit MetaProperty(const std::string& name);
 
     void setName(const std::string& name);
     std::string name() const;
 
     size_t size() const;
+    size_t line() const; /// Line in the source file, 0 if not read from a file
+
+    /// Values as written in the source file with the comment cut off, or as setArray() formatted them. Empty otherwise.
+    StringRef text() const;
 
     std::string get(size_t i) const;
     int stoi(size_t i) const;
@@ -41,6 +68,13 @@ public:
     double stod(size_t i) const;
     long double stold(size_t i) const;
 
+    /// Parse the first min(n, size()) values into out in one pass and return how many were written.
+    /// Unlike stof and stoi the whole value must be a decimal number, or inf or nan for floats;
+    /// anything else throws InvalidMetaPropFile with the line.
+    size_t parse(float* out, size_t n) const noexcept(false);
+    size_t parse(uint16* out, size_t n) const noexcept(false);
+    size_t parse(uint32* out, size_t n) const noexcept(false);
+
     const std::string& operator [](size_t i) const;
     std::string& operator [](size_t i);
 
@@ -50,14 +84,38 @@ public:
         this->operator[](i) = std::to_string(val);
     }
 
+    /// Written with the fewest digits that read back as the same float or double
+    void set(size_t i, float val);
+    void set(size_t i, double val);
+
+    /// Replace all values with n numbers formatted into one text. Floats are written as set() does.
+    void setArray(const float* values, size_t n);
+    void setArray(const uint16* values, size_t n);
+    void setArray(const uint32* values, size_t n);
+
     std::string asString() const;
+
+private:
+    MetaProperty(StringRef name, StringRef text, size_t numTokens, size_t line,
+        const std::shared_ptr<const MappedFile>& source);
+
+    const std::vector<StringRef>& tokens() const;
+    void own() const;
+    void setText(std::string&& text, size_t numTokens);
+    void appendTo(std::string& out) const;
+
+    /// Calls f(i, value) for the first min(n, size()) values without splitting or copying them
+    template <class F>
+    size_t forEachValue(size_t n, F f) const;
 };
 
 class MetaPropGroup
 {
 private:
+    friend class MetaPropFile;
+
     std::string name_;
-    std::unordered_map<std::string, MetaProperty> propTable_;
+    HashMap<std::string, MetaProperty> propTable_;
 
 public:
     MetaPropGroup() = default;
@@ -66,19 +124,40 @@ public:
     void setName(const std::string& name);
     std::string name() const;
 
-    bool has(const std::string& name) const;
+    bool has(StringRef name) const;
     void add(const MetaProperty& prop);
-    const MetaProperty& get(const std::string& name) const;
+    void add(MetaProperty&& prop);
+    const MetaProperty& get(StringRef name) const;
 
     std::string asString() const;
+
+private:
+    std::vector<const MetaProperty*> sortedProperties() const;
+};
+
+/// Receives the contents of a MetaProp file in file order from MetaPropFile::stream.
+/// The _Header group is reported like any other group.
+class MetaPropHandler
+{
+public:
+    virtual ~MetaPropHandler() = default;
+
+    virtual void beginGroup(StringRef name) = 0;
+    virtual void endGroup(StringRef name) = 0;
+
+    /// Values are spans over the mapped file. A copy of prop keeps the file mapped; names do not outlive the call.
+    virtual void property(const MetaProperty& prop) = 0;
 };
 
 class MetaPropFile
 {
 private:
+    struct GroupIndex;
+
     std::string auther_;
     std::string comment_;
-    std::unordered_map<std::string, MetaPropGroup> groupTable_;
+    HashMap<std::string, MetaPropGroup> groupTable_;
+    std::shared_ptr<GroupIndex> index_; /// Groups of readIndexed() not parsed yet
 
 public:
     std::string auther() const;
@@ -87,12 +166,47 @@ public:
     void setAuther(const std::string& auther);
     void setComment(const std::string& comment);
 
-    bool has(const std::string& name) const;
+    bool has(StringRef name) const;
     void add(const MetaPropGroup& group);
-    const MetaPropGroup& get(const std::string& name) const;
+    void add(MetaPropGroup&& group);
+    const MetaPropGroup& get(StringRef name) const;
 
+    /// Maps the file and parses it in one pass without copying values
     void read(const std::string& path) noexcept(false);
+
+    /// Same result as read(). Lines are split and checked in chunks on jobSystem, then added in file order.
+    void readParallel(const std::string& path) noexcept(false);
+
+    /// Maps the file and only finds where its groups begin; _Header is read at once.
+    /// A group is parsed on its first get() and kept. has() and get() may be called from several threads,
+    /// and so may the const members of the groups and properties returned, except MetaProperty::operator [],
+    /// which converts the values to strings.
+    /// Syntax errors inside a group are thrown by its first get(), none for a group hidden by a later one of the same name.
+    void readIndexed(const std::string& path) noexcept(false);
+
+    /// Parses the file calling handler for each group and property without building a MetaPropFile.
+    /// Parsed lines are dropped from memory as it goes, so peak memory is about the longest line.
+    static void stream(const std::string& path, MetaPropHandler& handler) noexcept(false);
+
+    /// Groups and properties are written sorted by name, so the output depends only on the contents.
+    /// The text is written in blocks of about 1 MB as it is formatted.
     void write(const std::string& path) noexcept(false);
+
+    /// Writes the binary encoding read by BinaryMetaPropFile. Value types are inferred as BinaryMetaPropWriter::add() does.
+    void writeBinary(const std::string& path) noexcept(false);
+
+private:
+    static void parse(const std::string& path, MetaPropHandler& handler, bool releaseParsed, bool parallel);
+
+    /// Parses text, a part of source starting after firstLine lines
+    static void parse(const std::shared_ptr<const MappedFile>& source, StringRef text, size_t firstLine,
+        const std::string& path, MetaPropHandler& handler, bool releaseParsed, bool parallel);
+
+    const MetaPropGroup* findIndexed(StringRef name) const noexcept(false);
+
+    /// Calls f(group) for every group, parsing indexed ones
+    template <class F>
+    void forEachGroup(F f) const;
 };
 
 GF_NAMESPACE_END
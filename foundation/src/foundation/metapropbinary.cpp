@@ -0,0 +1,714 @@
+#include "metapropbinary.h"
+#include "exception.h"
+#include <fstream>
+#include <algorithm>
+#include <utility>
+#include <cstdlib>
+#include <cstring>
+
+GF_NAMESPACE_BEGIN
+
+namespace detail
+{
+    struct MetaPropBinarySpan
+    {
+        uint64 offset;
+        uint64 size;
+    };
+
+    struct MetaPropBinaryHeader
+    {
+        char magic[4];
+        uint32 version;
+        uint32 numGroups;
+        uint32 numProps;
+        MetaPropBinarySpan auther;
+        MetaPropBinarySpan comment;
+    };
+
+    struct MetaPropBinaryGroupEntry
+    {
+        MetaPropBinarySpan name;
+        uint32 firstProp;
+        uint32 numProps;
+    };
+
+    struct MetaPropBinaryPropEntry
+    {
+        MetaPropBinarySpan name;
+        uint32 type;
+        uint32 reserved;
+        uint64 count;
+        uint64 offset; /// Elements, or count spans for strings
+    };
+
+    static_assert(sizeof(MetaPropBinaryHeader) == 48, "Binary layout changed");
+    static_assert(sizeof(MetaPropBinaryGroupEntry) == 24, "Binary layout changed");
+    static_assert(sizeof(MetaPropBinaryPropEntry) == 40, "Binary layout changed");
+}
+
+namespace
+{
+    using Span = detail::MetaPropBinarySpan;
+    using Header = detail::MetaPropBinaryHeader;
+    using GroupEntry = detail::MetaPropBinaryGroupEntry;
+    using PropEntry = detail::MetaPropBinaryPropEntry;
+
+    const char MAGIC[4] = { 'G', 'F', 'M', 'P' };
+    const uint32 VERSION = 1;
+    const size_t ARRAY_ALIGNMENT = 8;
+
+    bool isLittleEndian()
+    {
+        const uint16 one = 1;
+        return *reinterpret_cast<const uint8*>(&one) == 1;
+    }
+
+    size_t elementSize(MetaPropType type)
+    {
+        switch (type)
+        {
+        case MetaPropType::_float32: return sizeof(float);
+        case MetaPropType::_uint16: return sizeof(uint16);
+        case MetaPropType::_uint32: return sizeof(uint32);
+        case MetaPropType::_string: return sizeof(Span);
+        default: return 0;
+        }
+    }
+
+    std::string typeName(MetaPropType type)
+    {
+        switch (type)
+        {
+        case MetaPropType::_float32: return "float32";
+        case MetaPropType::_uint16: return "uint16";
+        case MetaPropType::_uint32: return "uint32";
+        case MetaPropType::_string: return "string";
+        default: return "unknown";
+        }
+    }
+
+    StringRef toString(const char* base, const Span& span)
+    {
+        return StringRef(base + span.offset, static_cast<size_t>(span.size));
+    }
+
+    const Header& headerOf(const char* base)
+    {
+        return *reinterpret_cast<const Header*>(base);
+    }
+
+    const GroupEntry* groupsOf(const char* base)
+    {
+        return reinterpret_cast<const GroupEntry*>(base + sizeof(Header));
+    }
+
+    const PropEntry* propsOf(const char* base)
+    {
+        return reinterpret_cast<const PropEntry*>(base + sizeof(Header) + headerOf(base).numGroups * sizeof(GroupEntry));
+    }
+
+    template <class Entry>
+    const Entry* findByName(const char* base, const Entry* first, const Entry* last, StringRef name)
+    {
+        const auto found = std::lower_bound(first, last, name, [base](const Entry& e, StringRef n)
+        {
+            return toString(base, e.name) < n;
+        });
+        return found != last && toString(base, found->name) == name ? found : nullptr;
+    }
+
+    /// Checks every offset and size in the index so that views need no bounds checks
+    void validate(const MappedFile& file, const std::string& path)
+    {
+        const auto error = [&path](const std::string& what)
+        {
+            return "Invalid binary MetaProp file " + path + ". " + what;
+        };
+
+        const auto base = file.data();
+        const auto size = static_cast<uint64>(file.size());
+        const auto inFile = [size](const Span& span)
+        {
+            return span.offset <= size && span.size <= size - span.offset;
+        };
+
+        enforce<InvalidMetaPropFile>(isLittleEndian(), error("Big endian hosts are not supported."));
+        enforce<InvalidMetaPropFile>(size >= sizeof(Header) && std::memcmp(base, MAGIC, sizeof(MAGIC)) == 0,
+            error("Bad magic."));
+
+        const auto& header = headerOf(base);
+        enforce<InvalidMetaPropFile>(header.version == VERSION, error("Unknown version " + std::to_string(header.version) + "."));
+
+        const auto indexSize = sizeof(Header) + static_cast<uint64>(header.numGroups) * sizeof(GroupEntry) +
+            static_cast<uint64>(header.numProps) * sizeof(PropEntry);
+        enforce<InvalidMetaPropFile>(indexSize <= size, error("Truncated index."));
+        enforce<InvalidMetaPropFile>(inFile(header.auther) && inFile(header.comment), error("Bad header."));
+
+        const auto groups = groupsOf(base);
+        const auto props = propsOf(base);
+
+        for (uint32 g = 0; g < header.numGroups; ++g)
+        {
+            const auto& group = groups[g];
+            enforce<InvalidMetaPropFile>(inFile(group.name), error("Bad group name."));
+            enforce<InvalidMetaPropFile>(g == 0 || toString(base, groups[g - 1].name) < toString(base, group.name),
+                error("Groups are not sorted."));
+            enforce<InvalidMetaPropFile>(group.firstProp <= header.numProps && group.numProps <= header.numProps - group.firstProp,
+                error("Bad property range in @" + toString(base, group.name).str() + "."));
+
+            for (uint32 p = group.firstProp; p < group.firstProp + group.numProps; ++p)
+            {
+                const auto& prop = props[p];
+                enforce<InvalidMetaPropFile>(inFile(prop.name), error("Bad property name."));
+                enforce<InvalidMetaPropFile>(p == group.firstProp || toString(base, props[p - 1].name) < toString(base, prop.name),
+                    error("Properties are not sorted."));
+
+                const auto propError = [&](const std::string& what)
+                {
+                    return error(toString(base, prop.name).str() + " in @" + toString(base, group.name).str() + ": " + what);
+                };
+
+                const auto type = static_cast<MetaPropType>(prop.type);
+                const auto elemSize = elementSize(type);
+                enforce<InvalidMetaPropFile>(elemSize > 0, propError("Unknown type."));
+                enforce<InvalidMetaPropFile>(prop.offset <= size && prop.count <= (size - prop.offset) / elemSize,
+                    propError("Values out of file."));
+                enforce<InvalidMetaPropFile>(prop.offset % std::min(elemSize, ARRAY_ALIGNMENT) == 0, propError("Misaligned values."));
+
+                if (type == MetaPropType::_string)
+                {
+                    const auto strings = reinterpret_cast<const Span*>(base + prop.offset);
+                    for (uint64 i = 0; i < prop.count; ++i)
+                    {
+                        enforce<InvalidMetaPropFile>(inFile(strings[i]), propError("String out of file."));
+                    }
+                }
+            }
+        }
+    }
+
+    /// As MetaProperty writes it
+    std::string format(float f)
+    {
+        char buf[32];
+        return std::string(buf, detail::formatFloat(f, buf));
+    }
+
+    template <class From, class To>
+    void convert(const char* src, size_t n, To* out)
+    {
+        const auto from = reinterpret_cast<const From*>(src);
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = static_cast<To>(from[i]);
+        }
+    }
+
+    /// Digits only, within uint32 and without leading zeros so that std::to_string gives s back
+    bool toUnsigned(const std::string& s, uint32& out)
+    {
+        if (s.empty() || s.size() > 10 || (s.size() > 1 && s[0] == '0'))
+        {
+            return false;
+        }
+
+        uint64 value = 0;
+        for (const auto c : s)
+        {
+            if (c < '0' || c > '9')
+            {
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+
+        if (value > 0xffffffff)
+        {
+            return false;
+        }
+        out = static_cast<uint32>(value);
+        return true;
+    }
+
+    /// Decimal notation only, and only as format() writes the value so that the text reads back unchanged.
+    /// strtof alone would also take hexadecimals, inf and nan.
+    bool toFloat(const std::string& s, float& out)
+    {
+        if (s.empty() || s.find_first_not_of("0123456789+-.eE") != std::string::npos)
+        {
+            return false;
+        }
+
+        char* end;
+        out = std::strtof(s.c_str(), &end);
+        return end == s.c_str() + s.size() && format(out) == s;
+    }
+
+    Span append(std::vector<char>& out, const void* data, size_t size, size_t alignment = 1)
+    {
+        out.resize((out.size() + alignment - 1) / alignment * alignment);
+        Span span;
+        span.offset = out.size();
+        span.size = size;
+        out.insert(std::end(out), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+        return span;
+    }
+}
+
+BinaryMetaProperty::BinaryMetaProperty(const char* base, const detail::MetaPropBinaryPropEntry* entry)
+    : base_(base)
+    , entry_(entry)
+{
+}
+
+StringRef BinaryMetaProperty::name() const
+{
+    return toString(base_, entry_->name);
+}
+
+MetaPropType BinaryMetaProperty::type() const
+{
+    return static_cast<MetaPropType>(entry_->type);
+}
+
+size_t BinaryMetaProperty::size() const
+{
+    return static_cast<size_t>(entry_->count);
+}
+
+const float* BinaryMetaProperty::floats() const
+{
+    enforce<InvalidMetaPropFile>(type() == MetaPropType::_float32, name().str() + " is " + typeName(type()) + ", not float32.");
+    return reinterpret_cast<const float*>(base_ + entry_->offset);
+}
+
+const uint16* BinaryMetaProperty::uint16s() const
+{
+    enforce<InvalidMetaPropFile>(type() == MetaPropType::_uint16, name().str() + " is " + typeName(type()) + ", not uint16.");
+    return reinterpret_cast<const uint16*>(base_ + entry_->offset);
+}
+
+const uint32* BinaryMetaProperty::uint32s() const
+{
+    enforce<InvalidMetaPropFile>(type() == MetaPropType::_uint32, name().str() + " is " + typeName(type()) + ", not uint32.");
+    return reinterpret_cast<const uint32*>(base_ + entry_->offset);
+}
+
+StringRef BinaryMetaProperty::string(size_t i) const
+{
+    check(i < size());
+    enforce<InvalidMetaPropFile>(type() == MetaPropType::_string, name().str() + " is " + typeName(type()) + ", not string.");
+    return toString(base_, reinterpret_cast<const Span*>(base_ + entry_->offset)[i]);
+}
+
+std::string BinaryMetaProperty::get(size_t i) const
+{
+    check(i < size());
+    switch (type())
+    {
+    case MetaPropType::_float32: return format(floats()[i]);
+    case MetaPropType::_uint16: return std::to_string(uint16s()[i]);
+    case MetaPropType::_uint32: return std::to_string(uint32s()[i]);
+    default: return string(i).str();
+    }
+}
+
+std::string BinaryMetaProperty::operator [](size_t i) const
+{
+    return get(i);
+}
+
+int BinaryMetaProperty::stoi(size_t i) const
+{
+    check(i < size());
+    switch (type())
+    {
+    case MetaPropType::_float32: return static_cast<int>(floats()[i]);
+    case MetaPropType::_uint16: return uint16s()[i];
+    case MetaPropType::_uint32: return static_cast<int>(uint32s()[i]);
+    default: return std::stoi(get(i));
+    }
+}
+
+unsigned long BinaryMetaProperty::stoul(size_t i) const
+{
+    check(i < size());
+    switch (type())
+    {
+    case MetaPropType::_float32: return static_cast<unsigned long>(floats()[i]);
+    case MetaPropType::_uint16: return uint16s()[i];
+    case MetaPropType::_uint32: return uint32s()[i];
+    default: return std::stoul(get(i));
+    }
+}
+
+float BinaryMetaProperty::stof(size_t i) const
+{
+    check(i < size());
+    switch (type())
+    {
+    case MetaPropType::_float32: return floats()[i];
+    case MetaPropType::_uint16: return uint16s()[i];
+    case MetaPropType::_uint32: return static_cast<float>(uint32s()[i]);
+    default: return std::stof(get(i));
+    }
+}
+
+void BinaryMetaProperty::copyTo(float* out) const
+{
+    const auto src = base_ + entry_->offset;
+    switch (type())
+    {
+    case MetaPropType::_float32: std::memcpy(out, src, size() * sizeof(float)); break;
+    case MetaPropType::_uint16: convert<uint16>(src, size(), out); break;
+    case MetaPropType::_uint32: convert<uint32>(src, size(), out); break;
+    default: throw InvalidMetaPropFile(name().str() + " is not numeric.");
+    }
+}
+
+void BinaryMetaProperty::copyTo(uint16* out) const
+{
+    const auto src = base_ + entry_->offset;
+    switch (type())
+    {
+    case MetaPropType::_float32: convert<float>(src, size(), out); break;
+    case MetaPropType::_uint16: std::memcpy(out, src, size() * sizeof(uint16)); break;
+    case MetaPropType::_uint32: convert<uint32>(src, size(), out); break;
+    default: throw InvalidMetaPropFile(name().str() + " is not numeric.");
+    }
+}
+
+void BinaryMetaProperty::copyTo(uint32* out) const
+{
+    const auto src = base_ + entry_->offset;
+    switch (type())
+    {
+    case MetaPropType::_float32: convert<float>(src, size(), out); break;
+    case MetaPropType::_uint16: convert<uint16>(src, size(), out); break;
+    case MetaPropType::_uint32: std::memcpy(out, src, size() * sizeof(uint32)); break;
+    default: throw InvalidMetaPropFile(name().str() + " is not numeric.");
+    }
+}
+
+BinaryMetaPropGroup::BinaryMetaPropGroup(const char* base, const detail::MetaPropBinaryGroupEntry* entry)
+    : base_(base)
+    , entry_(entry)
+{
+}
+
+StringRef BinaryMetaPropGroup::name() const
+{
+    return toString(base_, entry_->name);
+}
+
+size_t BinaryMetaPropGroup::size() const
+{
+    return entry_->numProps;
+}
+
+bool BinaryMetaPropGroup::has(StringRef name) const
+{
+    const auto first = propsOf(base_) + entry_->firstProp;
+    return findByName(base_, first, first + entry_->numProps, name) != nullptr;
+}
+
+BinaryMetaProperty BinaryMetaPropGroup::get(StringRef name) const
+{
+    const auto first = propsOf(base_) + entry_->firstProp;
+    const auto found = findByName(base_, first, first + entry_->numProps, name);
+    check(found);
+    return BinaryMetaProperty(base_, found);
+}
+
+BinaryMetaProperty BinaryMetaPropGroup::at(size_t i) const
+{
+    check(i < size());
+    return BinaryMetaProperty(base_, propsOf(base_) + entry_->firstProp + i);
+}
+
+BinaryMetaPropFile::BinaryMetaPropFile(const std::string& path)
+    : file_()
+{
+    open(path);
+}
+
+void BinaryMetaPropFile::open(const std::string& path)
+{
+    close();
+
+    MappedFile file(path);
+    validate(file, path);
+    file_ = std::move(file);
+}
+
+void BinaryMetaPropFile::close()
+{
+    file_.close();
+}
+
+bool BinaryMetaPropFile::isOpen() const
+{
+    return file_.isOpen();
+}
+
+StringRef BinaryMetaPropFile::auther() const
+{
+    check(isOpen());
+    return toString(file_.data(), headerOf(file_.data()).auther);
+}
+
+StringRef BinaryMetaPropFile::comment() const
+{
+    check(isOpen());
+    return toString(file_.data(), headerOf(file_.data()).comment);
+}
+
+size_t BinaryMetaPropFile::size() const
+{
+    return isOpen() ? headerOf(file_.data()).numGroups : 0;
+}
+
+bool BinaryMetaPropFile::has(StringRef name) const
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+    const auto first = groupsOf(file_.data());
+    return findByName(file_.data(), first, first + size(), name) != nullptr;
+}
+
+BinaryMetaPropGroup BinaryMetaPropFile::get(StringRef name) const
+{
+    check(isOpen());
+    const auto first = groupsOf(file_.data());
+    const auto found = findByName(file_.data(), first, first + size(), name);
+    check(found);
+    return BinaryMetaPropGroup(file_.data(), found);
+}
+
+BinaryMetaPropGroup BinaryMetaPropFile::at(size_t i) const
+{
+    check(i < size());
+    return BinaryMetaPropGroup(file_.data(), groupsOf(file_.data()) + i);
+}
+
+void BinaryMetaPropWriter::setAuther(const std::string& auther)
+{
+    auther_ = auther;
+}
+
+void BinaryMetaPropWriter::setComment(const std::string& comment)
+{
+    comment_ = comment;
+}
+
+void BinaryMetaPropWriter::beginGroup(const std::string& name)
+{
+    groups_.emplace_back();
+    groups_.back().name = name;
+}
+
+BinaryMetaPropWriter::Property& BinaryMetaPropWriter::addProperty(const std::string& name, MetaPropType type, size_t count)
+{
+    check(!groups_.empty());
+    auto& props = groups_.back().props;
+    props.emplace_back();
+
+    auto& prop = props.back();
+    prop.name = name;
+    prop.type = type;
+    prop.count = count;
+    return prop;
+}
+
+void BinaryMetaPropWriter::addFloats(const std::string& name, const float* values, size_t n)
+{
+    auto& prop = addProperty(name, MetaPropType::_float32, n);
+    prop.data.assign(reinterpret_cast<const char*>(values), reinterpret_cast<const char*>(values + n));
+}
+
+void BinaryMetaPropWriter::addUInt16s(const std::string& name, const uint16* values, size_t n)
+{
+    auto& prop = addProperty(name, MetaPropType::_uint16, n);
+    prop.data.assign(reinterpret_cast<const char*>(values), reinterpret_cast<const char*>(values + n));
+}
+
+void BinaryMetaPropWriter::addUInt32s(const std::string& name, const uint32* values, size_t n)
+{
+    auto& prop = addProperty(name, MetaPropType::_uint32, n);
+    prop.data.assign(reinterpret_cast<const char*>(values), reinterpret_cast<const char*>(values + n));
+}
+
+void BinaryMetaPropWriter::addStrings(const std::string& name, const std::string* values, size_t n)
+{
+    auto& prop = addProperty(name, MetaPropType::_string, n);
+    prop.strings.assign(values, values + n);
+}
+
+void BinaryMetaPropWriter::add(const MetaProperty& prop)
+{
+    const auto n = prop.size();
+    std::vector<std::string> values;
+    values.reserve(n);
+
+    bool allUnsigned = n > 0;
+    uint32 maxUnsigned = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        values.emplace_back(prop.get(i));
+
+        uint32 u;
+        allUnsigned = allUnsigned && toUnsigned(values.back(), u);
+        if (allUnsigned)
+        {
+            maxUnsigned = std::max(maxUnsigned, u);
+        }
+    }
+
+    // A numeric type only when every value reads back as the same text, "001", "1.10" or "16777217" stay strings
+    const auto allFloat = !allUnsigned && n > 0 && std::all_of(std::cbegin(values), std::cend(values), [](const std::string& s)
+    {
+        float f;
+        return toFloat(s, f);
+    });
+
+    if (allUnsigned && maxUnsigned <= 0xffff)
+    {
+        std::vector<uint16> u16(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint32 u;
+            toUnsigned(values[i], u);
+            u16[i] = static_cast<uint16>(u);
+        }
+        addUInt16s(prop.name(), u16.data(), n);
+    }
+    else if (allUnsigned)
+    {
+        std::vector<uint32> u32(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            toUnsigned(values[i], u32[i]);
+        }
+        addUInt32s(prop.name(), u32.data(), n);
+    }
+    else if (allFloat)
+    {
+        std::vector<float> f32(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            toFloat(values[i], f32[i]);
+        }
+        addFloats(prop.name(), f32.data(), n);
+    }
+    else
+    {
+        addStrings(prop.name(), values.data(), n);
+    }
+}
+
+void BinaryMetaPropWriter::write(const std::string& path) const
+{
+    enforce<InvalidMetaPropFile>(isLittleEndian(), "Big endian hosts are not supported.");
+
+    const auto byName = [](const auto* a, const auto* b) { return a->name < b->name; };
+    const auto sameName = [](const auto* a, const auto* b) { return a->name == b->name; };
+
+    std::vector<const Group*> groups;
+    for (const auto& g : groups_)
+    {
+        groups.emplace_back(&g);
+    }
+    std::sort(std::begin(groups), std::end(groups), byName);
+    const auto dupGroup = std::adjacent_find(std::cbegin(groups), std::cend(groups), sameName);
+    enforce<InvalidMetaPropFile>(dupGroup == std::cend(groups), "Duplicate group @" + (dupGroup == std::cend(groups) ? "" : (*dupGroup)->name) + ".");
+
+    size_t numProps = 0;
+    for (const auto g : groups)
+    {
+        numProps += g->props.size();
+    }
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.numGroups = static_cast<uint32>(groups.size());
+    header.numProps = static_cast<uint32>(numProps);
+
+    std::vector<GroupEntry> groupEntries(groups.size());
+    std::vector<PropEntry> propEntries(numProps);
+
+    // The index is filled in last, names and values follow it
+    std::vector<char> out(sizeof(Header) + groupEntries.size() * sizeof(GroupEntry) + propEntries.size() * sizeof(PropEntry));
+    header.auther = append(out, auther_.data(), auther_.size());
+    header.comment = append(out, comment_.data(), comment_.size());
+
+    uint32 propIndex = 0;
+    for (size_t gi = 0; gi < groups.size(); ++gi)
+    {
+        const auto& group = *groups[gi];
+
+        std::vector<const Property*> props;
+        for (const auto& p : group.props)
+        {
+            props.emplace_back(&p);
+        }
+        std::sort(std::begin(props), std::end(props), byName);
+        const auto dupProp = std::adjacent_find(std::cbegin(props), std::cend(props), sameName);
+        enforce<InvalidMetaPropFile>(dupProp == std::cend(props),
+            "Duplicate property " + (dupProp == std::cend(props) ? "" : (*dupProp)->name) + " in @" + group.name + ".");
+
+        auto& groupEntry = groupEntries[gi];
+        groupEntry.name = append(out, group.name.data(), group.name.size());
+        groupEntry.firstProp = propIndex;
+        groupEntry.numProps = static_cast<uint32>(props.size());
+
+        for (const auto p : props)
+        {
+            auto& propEntry = propEntries[propIndex++];
+            propEntry.name = append(out, p->name.data(), p->name.size());
+            propEntry.type = static_cast<uint32>(p->type);
+            propEntry.count = p->count;
+
+            if (p->type == MetaPropType::_string)
+            {
+                std::vector<Span> spans(p->count);
+                propEntry.offset = append(out, spans.data(), spans.size() * sizeof(Span), ARRAY_ALIGNMENT).offset;
+                for (size_t i = 0; i < p->count; ++i)
+                {
+                    spans[i] = append(out, p->strings[i].data(), p->strings[i].size());
+                }
+                if (!spans.empty())
+                {
+                    std::memcpy(out.data() + propEntry.offset, spans.data(), spans.size() * sizeof(Span));
+                }
+            }
+            else
+            {
+                propEntry.offset = append(out, p->data.data(), p->data.size(), ARRAY_ALIGNMENT).offset;
+            }
+        }
+    }
+
+    auto index = out.data();
+    std::memcpy(index, &header, sizeof(Header));
+    index += sizeof(Header);
+    if (!groupEntries.empty())
+    {
+        std::memcpy(index, groupEntries.data(), groupEntries.size() * sizeof(GroupEntry));
+        index += groupEntries.size() * sizeof(GroupEntry);
+    }
+    if (!propEntries.empty())
+    {
+        std::memcpy(index, propEntries.data(), propEntries.size() * sizeof(PropEntry));
+    }
+
+    std::ofstream stream(path, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    enforce<FileException>(stream.is_open(), "Failed open file (" + path + ").");
+    stream.write(out.data(), out.size());
+    enforce<FileException>(!stream.fail(), "Failed to write file (" + path + ").");
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef GAMEFRIENDS_METAPROPBINARY_H
+#define GAMEFRIENDS_METAPROPBINARY_H
+
+#include "metaprop.h"
+#include "mappedfile.h"
+#include "stringref.h"
+#include "prerequest.h"
+#include <string>
+#include <vector>
+
+GF_NAMESPACE_BEGIN
+
+/// Binary encoding of a MetaProp file. Values are typed little endian arrays read in place from the mapped file.
+///
+/// Layout, offsets from the start of the file:
+///   Header
+///   Group entries, sorted by name
+///   Property entries, those of a group contiguous and sorted by name
+///   Names and value arrays. Arrays are 8 byte aligned; a string array is count (offset, size) pairs followed by the characters.
+enum class MetaPropType : uint32
+{
+    _float32 = 1,
+    _uint16 = 2,
+    _uint32 = 3,
+    _string = 4,
+};
+
+namespace detail
+{
+    struct MetaPropBinaryGroupEntry;
+    struct MetaPropBinaryPropEntry;
+}
+
+/// View of a property in a BinaryMetaPropFile. Valid while the file is open.
+/// Mirrors the accessors of MetaProperty so that loaders can be written once for both.
+class BinaryMetaProperty
+{
+private:
+    const char* base_;
+    const detail::MetaPropBinaryPropEntry* entry_;
+
+public:
+    BinaryMetaProperty(const char* base, const detail::MetaPropBinaryPropEntry* entry);
+
+    StringRef name() const;
+    MetaPropType type() const;
+    size_t size() const;
+
+    /// Pointers into the mapped file. The type must match.
+    const float* floats() const;
+    const uint16* uint16s() const;
+    const uint32* uint32s() const;
+    StringRef string(size_t i) const;
+
+    /// Converting access to any element. Numbers are formatted and strings are parsed as needed.
+    std::string get(size_t i) const;
+    std::string operator [](size_t i) const;
+    int stoi(size_t i) const;
+    unsigned long stoul(size_t i) const;
+    float stof(size_t i) const;
+
+    /// Copies the elements into out, converting from any numeric type
+    void copyTo(float* out) const;
+    void copyTo(uint16* out) const;
+    void copyTo(uint32* out) const;
+};
+
+class BinaryMetaPropGroup
+{
+private:
+    const char* base_;
+    const detail::MetaPropBinaryGroupEntry* entry_;
+
+public:
+    BinaryMetaPropGroup(const char* base, const detail::MetaPropBinaryGroupEntry* entry);
+
+    StringRef name() const;
+    size_t size() const;
+
+    bool has(StringRef name) const;
+    BinaryMetaProperty get(StringRef name) const;
+    BinaryMetaProperty at(size_t i) const;
+};
+
+/// Reader of the binary encoding. Validates the whole index on open, then hands out views without copying.
+class BinaryMetaPropFile
+{
+private:
+    MappedFile file_;
+
+public:
+    BinaryMetaPropFile() = default;
+    explicit BinaryMetaPropFile(const std::string& path) noexcept(false);
+
+    void open(const std::string& path) noexcept(false);
+    void close();
+    bool isOpen() const;
+
+    StringRef auther() const;
+    StringRef comment() const;
+
+    size_t size() const;
+
+    bool has(StringRef name) const;
+    BinaryMetaPropGroup get(StringRef name) const;
+    BinaryMetaPropGroup at(size_t i) const;
+};
+
+/// Builds a binary MetaProp file. Groups and properties can be added in any order.
+class BinaryMetaPropWriter
+{
+private:
+    struct Property
+    {
+        std::string name;
+        MetaPropType type;
+        size_t count;
+        std::vector<char> data; /// Raw elements, unused for strings
+        std::vector<std::string> strings;
+    };
+
+    struct Group
+    {
+        std::string name;
+        std::vector<Property> props;
+    };
+
+    std::string auther_;
+    std::string comment_;
+    std::vector<Group> groups_;
+
+public:
+    void setAuther(const std::string& auther);
+    void setComment(const std::string& comment);
+
+    /// Following properties go to this group
+    void beginGroup(const std::string& name);
+
+    void addFloats(const std::string& name, const float* values, size_t n);
+    void addUInt16s(const std::string& name, const uint16* values, size_t n);
+    void addUInt32s(const std::string& name, const uint32* values, size_t n);
+    void addStrings(const std::string& name, const std::string* values, size_t n);
+
+    /// Stores the values of a text property with the narrowest type holding all of them:
+    /// unsigned integers as uint16 or uint32, other decimal numbers as float32, anything else as strings.
+    /// Numbers are typed only if get() gives every value back as written, so "001" or "1.10" stay strings.
+    void add(const MetaProperty& prop);
+
+    void write(const std::string& path) const noexcept(false);
+
+private:
+    Property& addProperty(const std::string& name, MetaPropType type, size_t count);
+};
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
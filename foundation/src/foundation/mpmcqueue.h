@@ -0,0 +1,247 @@
+#ifndef GAMEFRIENDS_MPMCQUEUE_H
+#define GAMEFRIENDS_MPMCQUEUE_H
+
+#include "queuewait.h"
+#include "prerequest.h"
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <new>
+
+GF_NAMESPACE_BEGIN
+
+/// Bounded multi producer, multi consumer ring queue (Vyukov).
+/// Every cell carries a sequence number telling whether it is ready for the producer or the consumer
+/// of a given lap, so a push or pop is one CAS on its index plus one store on the cell.
+template <class T>
+class MpmcQueue
+{
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    const size_t mask_;
+    const std::unique_ptr<Cell[]> cells_;
+    char pad0_[detail::CACHE_LINE_SIZE];
+
+    std::atomic<size_t> enqueuePos_;
+    char pad1_[detail::CACHE_LINE_SIZE - sizeof(size_t)];
+
+    std::atomic<size_t> dequeuePos_;
+    char pad2_[detail::CACHE_LINE_SIZE - sizeof(size_t)];
+
+    detail::QueueWait notEmpty_;
+    detail::QueueWait notFull_;
+
+public:
+    /// capacity is rounded up to a 2-power. Throws std::length_error above detail::MAX_QUEUE_CAPACITY.
+    explicit MpmcQueue(size_t capacity)
+        : mask_(detail::queueCapacity(capacity) - 1)
+        , cells_(new Cell[mask_ + 1])
+        , enqueuePos_(0)
+        , dequeuePos_(0)
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcQueue()
+    {
+        const auto end = enqueuePos_.load(std::memory_order_relaxed);
+        for (auto i = dequeuePos_.load(std::memory_order_relaxed); i != end; ++i)
+        {
+            reinterpret_cast<T&>(cells_[i & mask_].storage).~T();
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator =(const MpmcQueue&) = delete;
+
+    size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    /// Approximate when other threads are active
+    size_t size() const
+    {
+        const auto enq = enqueuePos_.load(std::memory_order_relaxed);
+        const auto deq = dequeuePos_.load(std::memory_order_relaxed);
+        return enq > deq ? enq - deq : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    template <class... Args>
+    bool tryEmplace(Args&&... args)
+    {
+        if (!emplaceImpl(std::forward<Args>(args)...))
+        {
+            return false;
+        }
+        notEmpty_.notify();
+        return true;
+    }
+
+    bool tryPush(const T& val)
+    {
+        return tryEmplace(val);
+    }
+
+    bool tryPush(T&& val)
+    {
+        return tryEmplace(std::move(val));
+    }
+
+    /// Pushes from [first, first + n) until full and wakes waiters once; returns the count.
+    /// Other producers may interleave.
+    template <class InputIterator>
+    size_t tryPushBulk(InputIterator first, size_t n)
+    {
+        size_t count = 0;
+        for (; count < n && emplaceImpl(*first); ++count, ++first)
+        {
+        }
+        if (count > 0)
+        {
+            notEmpty_.notify();
+        }
+        return count;
+    }
+
+    bool tryPop(T& out)
+    {
+        if (!popImpl(out))
+        {
+            return false;
+        }
+        notFull_.notify();
+        return true;
+    }
+
+    /// Pops up to n elements into out and wakes waiters once; returns the count.
+    template <class OutputIterator>
+    size_t tryPopBulk(OutputIterator out, size_t n)
+    {
+        size_t count = 0;
+        for (; count < n && popImpl(*out); ++count, ++out)
+        {
+        }
+        if (count > 0)
+        {
+            notFull_.notify();
+        }
+        return count;
+    }
+
+    /// Blocks while full
+    void push(T val)
+    {
+        while (!tryPush(std::move(val)))
+        {
+            notFull_.wait([this] { return pushReady(); });
+        }
+    }
+
+    /// Blocks while empty
+    void pop(T& out)
+    {
+        while (!tryPop(out))
+        {
+            notEmpty_.wait([this] { return popReady(); });
+        }
+    }
+
+private:
+    /// The cell at the enqueue position was released by its consumer, or another producer moved past it.
+    /// Unlike the indices, this stays false until a push can make progress, so waiters do not spin.
+    bool pushReady() const
+    {
+        const auto pos = enqueuePos_.load(std::memory_order_relaxed);
+        const auto seq = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+        return static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos) >= 0;
+    }
+
+    /// The cell at the dequeue position was filled by its producer, or another consumer moved past it
+    bool popReady() const
+    {
+        const auto pos = dequeuePos_.load(std::memory_order_relaxed);
+        const auto seq = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+        return static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) >= 0;
+    }
+
+    template <class... Args>
+    bool emplaceImpl(Args&&... args)
+    {
+        auto pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& cell = cells_[pos & mask_];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    new (&cell.storage) T(std::forward<Args>(args)...);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The consumer of the previous lap has not finished
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <class U>
+    bool popImpl(U& out)
+    {
+        auto pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& cell = cells_[pos & mask_];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    auto& val = reinterpret_cast<T&>(cell.storage);
+                    out = std::move(val);
+                    val.~T();
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The producer of this lap has not finished
+                return false;
+            }
+            else
+            {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "poolallocator.h"
+#include "exception.h"
+#include <algorithm>
+#include <new>
+
+GF_NAMESPACE_BEGIN
+
+namespace
+{
+    void*& nextOf(void* block)
+    {
+        return *static_cast<void**>(block);
+    }
+}
+
+PoolAllocator::PoolAllocator(size_t blockSize, size_t blockAlign, size_t blocksPerChunk)
+    : blockSize_(detail::alignUp(std::max(blockSize, sizeof(void*)), std::max(blockAlign, alignof(void*))))
+    , blockAlign_(std::max(blockAlign, alignof(void*)))
+    , blocksPerChunk_(blocksPerChunk)
+    , free_(nullptr)
+    , chunks_(nullptr)
+    , stats_()
+{
+    // align needs be a 2-power
+    check(((blockAlign - 1) & blockAlign) == 0);
+    check(blocksPerChunk > 0);
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    release();
+}
+
+void* PoolAllocator::allocate()
+{
+    if (!free_)
+    {
+        addChunk();
+    }
+
+    const auto p = free_;
+    free_ = nextOf(p);
+
+    stats_.used += blockSize_;
+    stats_.highWater = std::max(stats_.highWater, stats_.used);
+    ++stats_.allocations;
+    detail::poison(p, blockSize_, detail::POISON_ALLOCATED);
+    return p;
+}
+
+void PoolAllocator::deallocate(void* p) noexcept
+{
+    if (!p)
+    {
+        return;
+    }
+
+    check(stats_.used >= blockSize_);
+    detail::poison(p, blockSize_, detail::POISON_RELEASED);
+    nextOf(p) = free_;
+    free_ = p;
+    stats_.used -= blockSize_;
+}
+
+void* PoolAllocator::allocate(size_t size, size_t alignment)
+{
+    if (size > blockSize_ || alignment > blockAlign_)
+    {
+        throw std::bad_alloc();
+    }
+    return allocate();
+}
+
+void PoolAllocator::deallocate(void* p, size_t size) noexcept
+{
+    check(size <= blockSize_);
+    (void)size;
+    deallocate(p);
+}
+
+void PoolAllocator::release()
+{
+    check(stats_.used == 0);
+
+    while (chunks_)
+    {
+        const auto next = chunks_->next;
+        ::operator delete(chunks_);
+        chunks_ = next;
+    }
+    free_ = nullptr;
+    stats_.used = 0;
+    stats_.capacity = 0;
+}
+
+size_t PoolAllocator::blockSize() const
+{
+    return blockSize_;
+}
+
+AllocatorStats PoolAllocator::stats() const
+{
+    return stats_;
+}
+
+void PoolAllocator::addChunk()
+{
+    // The chunk header is followed by padding up to blockAlign_ and the blocks
+    const auto bytes = sizeof(Chunk) + blockAlign_ - 1 + blockSize_ * blocksPerChunk_;
+    const auto chunk = static_cast<Chunk*>(::operator new(bytes));
+    chunk->next = chunks_;
+    chunks_ = chunk;
+
+    const auto raw = reinterpret_cast<uintptr_t>(chunk + 1);
+    const auto first = reinterpret_cast<char*>(detail::alignUp(raw, blockAlign_));
+
+    // Link back to front so blocks are handed out in address order
+    for (auto i = blocksPerChunk_; i > 0; --i)
+    {
+        const auto block = first + (i - 1) * blockSize_;
+        nextOf(block) = free_;
+        free_ = block;
+    }
+    stats_.capacity += blockSize_ * blocksPerChunk_;
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef GAMEFRIENDS_POOLALLOCATOR_H
+#define GAMEFRIENDS_POOLALLOCATOR_H
+
+#include "allocator.h"
+#include "prerequest.h"
+#include <cstddef>
+#include <utility>
+
+GF_NAMESPACE_BEGIN
+
+/// Fixed size block allocator. Blocks are carved from chunks and recycled through an intrusive free list.
+/// Through StdAllocator it serves node based containers, which allocate one node at a time.
+class PoolAllocator
+{
+private:
+    struct Chunk
+    {
+        Chunk* next;
+    };
+
+    size_t blockSize_;
+    size_t blockAlign_;
+    size_t blocksPerChunk_;
+    void* free_;
+    Chunk* chunks_;
+    AllocatorStats stats_;
+
+public:
+    static const size_t DEFAULT_BLOCKS_PER_CHUNK = 256;
+
+    /// blockAlign needs be a 2-power
+    explicit PoolAllocator(size_t blockSize, size_t blockAlign = alignof(std::max_align_t),
+        size_t blocksPerChunk = DEFAULT_BLOCKS_PER_CHUNK);
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator =(const PoolAllocator&) = delete;
+
+    void* allocate() noexcept(false);
+    void deallocate(void* p) noexcept;
+
+    /// For StdAllocator. Throws std::bad_alloc if a request does not fit one block.
+    void* allocate(size_t size, size_t alignment) noexcept(false);
+    void deallocate(void* p, size_t size) noexcept;
+
+    /// Returns all chunks to the system. Every block must have been deallocated.
+    void release();
+
+    size_t blockSize() const;
+    AllocatorStats stats() const;
+
+private:
+    void addChunk();
+};
+
+template <class T>
+using PoolStdAllocator = StdAllocator<T, PoolAllocator>;
+
+/// Typed pool constructing objects in place
+template <class T>
+class ObjectPool
+{
+private:
+    PoolAllocator pool_;
+
+public:
+    explicit ObjectPool(size_t blocksPerChunk = PoolAllocator::DEFAULT_BLOCKS_PER_CHUNK)
+        : pool_(sizeof(T), alignof(T), blocksPerChunk)
+    {
+    }
+
+    template <class... Args>
+    T* create(Args&&... args)
+    {
+        const auto p = pool_.allocate();
+        try
+        {
+            return new (p) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            pool_.deallocate(p);
+            throw;
+        }
+    }
+
+    void destroy(T* p) noexcept
+    {
+        if (p)
+        {
+            p->~T();
+            pool_.deallocate(p);
+        }
+    }
+
+    AllocatorStats stats() const
+    {
+        return pool_.stats();
+    }
+};
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
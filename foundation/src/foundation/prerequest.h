@@ -24,6 +24,10 @@
     #endif
 #endif
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define GF_SSE
+#endif
+
 #ifdef __COUNTER__
     #define GF_COUNTER __COUNTER__
     #define GF_ID __COUNTER__
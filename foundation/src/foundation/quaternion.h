@@ -1,7 +1,10 @@
 #ifndef GAMEFRIENDS_QUATERNION_H
 #define GAMEFRIENDS_QUATERNION_H
 
+#include "math.h"
+#include "exception.h"
 #include "prerequest.h"
+#include <cmath>
 
 GF_NAMESPACE_BEGIN
 
@@ -13,7 +16,7 @@ public:
     float w, x, y, z;
 
     Quaternion() = default;
-    Quaternion(float nw, float nx, float ny, float nz);
+    constexpr Quaternion(float nw, float nx, float ny, float nz);
     Quaternion(const Quaternion&) = default;
 
     Quaternion& operator =(const Quaternion&) = default;
@@ -25,8 +28,8 @@ public:
     float angle() const;
     float norm() const;
     Quaternion inverse() const;
-    Quaternion conjugate() const;
-    float dot(const Quaternion& q) const;
+    constexpr Quaternion conjugate() const;
+    constexpr float dot(const Quaternion& q) const;
 
     void normalize();
 
@@ -36,13 +39,13 @@ public:
 bool operator ==(const Quaternion& a, const Quaternion& b);
 bool operator !=(const Quaternion& a, const Quaternion& b);
 
-const Quaternion operator +(const Quaternion& q);
-const Quaternion operator -(const Quaternion& q);
+constexpr const Quaternion operator +(const Quaternion& q);
+constexpr const Quaternion operator -(const Quaternion& q);
 
-const Quaternion operator +(const Quaternion& a, const Quaternion& b);
-const Quaternion operator -(const Quaternion& a, const Quaternion& b);
-const Quaternion operator *(const Quaternion& a, const Quaternion& b);
-const Quaternion operator *(const Quaternion& q, float k);
+constexpr const Quaternion operator +(const Quaternion& a, const Quaternion& b);
+constexpr const Quaternion operator -(const Quaternion& a, const Quaternion& b);
+constexpr const Quaternion operator *(const Quaternion& a, const Quaternion& b);
+constexpr const Quaternion operator *(const Quaternion& q, float k);
 
 Quaternion& operator +=(Quaternion& a, const Quaternion& b);
 Quaternion& operator -=(Quaternion& a, const Quaternion& b);
@@ -51,6 +54,131 @@ Quaternion& operator *=(Quaternion& q, float k);
 
 Quaternion makeQuaternion(const Vector3& axis, float rad); // NODE: Need unit axis
 
+constexpr Quaternion::Quaternion(float nw, float nx, float ny, float nz)
+    : w(nw)
+    , x(nx)
+    , y(ny)
+    , z(nz)
+{
+}
+
+inline const float& Quaternion::operator [](size_t i) const
+{
+    return const_cast<Quaternion&>(*this)[i];
+}
+
+inline float& Quaternion::operator [](size_t i)
+{
+    switch (i)
+    {
+    case 0: return w;
+    case 1: return x;
+    case 2: return y;
+    case 3: return z;
+    default:
+        check(false);
+        return w; // For warnings
+    }
+}
+
+inline float Quaternion::norm() const
+{
+    return std::sqrt(w * w + x * x + y * y + z * z);
+}
+
+inline Quaternion Quaternion::inverse() const
+{
+    check(!equalf(norm(), 0));
+    const auto mag = norm();
+    const auto conj = conjugate();
+    return conj * (1 / (mag * mag));
+}
+
+constexpr Quaternion Quaternion::conjugate() const
+{
+    return{ w, -x, -y, -z };
+}
+
+constexpr float Quaternion::dot(const Quaternion& q) const
+{
+    return w * q.w + x * q.x + y * q.y + z * q.z;
+}
+
+inline void Quaternion::normalize()
+{
+    check(!equalf(norm(), 0));
+    *this *= (1 / norm());
+}
+
+inline bool operator ==(const Quaternion& a, const Quaternion& b)
+{
+    return equalf(a.w, b.w) && equalf(a.x, b.x) && equalf(a.y, b.y) && equalf(a.z, b.z);
+}
+
+inline bool operator !=(const Quaternion& a, const Quaternion& b)
+{
+    return !(a == b);
+}
+
+constexpr const Quaternion operator +(const Quaternion& q)
+{
+    return q;
+}
+
+constexpr const Quaternion operator -(const Quaternion& q)
+{
+    return{ -q.w, -q.x, -q.y, -q.z };
+}
+
+constexpr const Quaternion operator +(const Quaternion& a, const Quaternion& b)
+{
+    return{ a.w + b.w, a.x + b.x, a.y + b.y, a.z + b.z };
+}
+
+constexpr const Quaternion operator -(const Quaternion& a, const Quaternion& b)
+{
+    return{ a.w - b.w, a.x - b.x, a.y - b.y, a.z - b.z };
+}
+
+constexpr const Quaternion operator *(const Quaternion& a, const Quaternion& b)
+{
+    return{
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+        a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x
+    };
+}
+
+constexpr const Quaternion operator *(const Quaternion& q, float k)
+{
+    return{ q.w * k, q.x * k, q.y * k, q.z * k };
+}
+
+inline Quaternion& operator +=(Quaternion& a, const Quaternion& b)
+{
+    a = a + b;
+    return a;
+}
+
+inline Quaternion& operator -=(Quaternion& a, const Quaternion& b)
+{
+    a = a - b;
+    return a;
+}
+
+inline Quaternion& operator *=(Quaternion& a, const Quaternion& b)
+{
+    a = a * b;
+    return a;
+}
+
+inline Quaternion& operator *=(Quaternion& q, float k)
+{
+    q = q * k;
+    return q;
+}
+
 GF_NAMESPACE_END
 
 #endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef GAMEFRIENDS_QUEUEWAIT_H
+#define GAMEFRIENDS_QUEUEWAIT_H
+
+#include "math.h"
+#include "exception.h"
+#include "prerequest.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <thread>
+
+GF_NAMESPACE_BEGIN
+
+namespace detail
+{
+    const size_t CACHE_LINE_SIZE = 64;
+
+    /// Index differences must fit in intptr_t, and ceilingPow2 must not overflow
+    const size_t MAX_QUEUE_CAPACITY = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 2);
+
+    /// capacity rounded up to a 2-power of at least 2
+    inline size_t queueCapacity(size_t capacity) noexcept(false)
+    {
+        enforce<std::length_error>(capacity <= MAX_QUEUE_CAPACITY, "Queue capacity too large.");
+        return ceilingPow2(capacity < 2 ? 2 : capacity);
+    }
+
+    /// Blocking support for lock-free queues.
+    /// Waiters spin briefly, then sleep on a condition variable. notify() is a fence and a relaxed load unless
+    /// someone sleeps, so non-blocking operations never take the mutex.
+    class QueueWait
+    {
+    private:
+        static const int SPIN_COUNT = 128;
+
+        std::atomic<int32> sleepers_;
+        std::mutex mutex_;
+        std::condition_variable cond_;
+
+    public:
+        QueueWait()
+            : sleepers_(0)
+        {
+        }
+
+        QueueWait(const QueueWait&) = delete;
+        QueueWait& operator =(const QueueWait&) = delete;
+
+        /// Call after making progress visible
+        void notify()
+        {
+            // Pairs with the fence in wait(): either the waiter sees the progress or this sees the waiter
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleepers_.load(std::memory_order_relaxed) > 0)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                cond_.notify_all();
+            }
+        }
+
+        /// Blocks until ready() returns true
+        template <class Pred>
+        void wait(Pred ready)
+        {
+            for (int i = 0; i < SPIN_COUNT; ++i)
+            {
+                if (ready())
+                {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleepers_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            cond_.wait(lock, ready);
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+}
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "slotmap.h"
+
+GF_NAMESPACE_BEGIN
+
+SlotTable::SlotTable()
+    : freeHead_(SlotHandle::INVALID_INDEX)
+{
+}
+
+SlotHandle SlotTable::insert()
+{
+    enforce<std::length_error>(denseToSlot_.size() < SlotHandle::INVALID_INDEX, "SlotTable is full.");
+
+    uint32 index;
+    if (freeHead_ != SlotHandle::INVALID_INDEX)
+    {
+        index = freeHead_;
+        freeHead_ = slots_[index].dense;
+    }
+    else
+    {
+        index = static_cast<uint32>(slots_.size());
+        slots_.push_back(Slot{ 0, 0 });
+    }
+
+    try
+    {
+        denseToSlot_.push_back(index);
+    }
+    catch (...)
+    {
+        slots_[index].dense = freeHead_;
+        freeHead_ = index;
+        throw;
+    }
+
+    auto& slot = slots_[index];
+    slot.dense = static_cast<uint32>(denseToSlot_.size() - 1);
+
+    SlotHandle handle;
+    handle.index = index;
+    handle.generation = slot.generation;
+    return handle;
+}
+
+size_t SlotTable::erase(SlotHandle handle)
+{
+    check(contains(handle));
+
+    auto& slot = slots_[handle.index];
+    const auto dense = slot.dense;
+
+    const auto lastSlot = denseToSlot_.back();
+    denseToSlot_[dense] = lastSlot;
+    slots_[lastSlot].dense = dense;
+    denseToSlot_.pop_back();
+
+    ++slot.generation;
+    slot.dense = freeHead_;
+    freeHead_ = handle.index;
+    return dense;
+}
+
+void SlotTable::clear()
+{
+    for (const auto index : denseToSlot_)
+    {
+        auto& slot = slots_[index];
+        ++slot.generation;
+        slot.dense = freeHead_;
+        freeHead_ = index;
+    }
+    denseToSlot_.clear();
+}
+
+void SlotTable::reserve(size_t n)
+{
+    slots_.reserve(n);
+    denseToSlot_.reserve(n);
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,186 @@
+#ifndef GAMEFRIENDS_SLOTMAP_H
+#define GAMEFRIENDS_SLOTMAP_H
+
+#include "exception.h"
+#include "prerequest.h"
+#include <vector>
+#include <functional>
+#include <utility>
+#include <stdexcept>
+#include <cstddef>
+
+GF_NAMESPACE_BEGIN
+
+/// Stable reference into a SlotTable. The generation tells a reused slot from the one the handle was made for.
+struct SlotHandle
+{
+    static const uint32 INVALID_INDEX = 0xffffffff;
+
+    uint32 index = INVALID_INDEX;
+    uint32 generation = 0;
+
+    bool valid() const { return index != INVALID_INDEX; }
+};
+
+inline bool operator ==(SlotHandle a, SlotHandle b) { return a.index == b.index && a.generation == b.generation; }
+inline bool operator !=(SlotHandle a, SlotHandle b) { return !(a == b); }
+
+/// Hands out generational handles to dense indices [0, size()).
+/// Owners keep one or more arrays in dense order, so iteration is contiguous whatever the handles are.
+/// erase() moves the last element into the hole; owners mirror it with swapRemove() on each array.
+class SlotTable
+{
+private:
+    struct Slot
+    {
+        uint32 dense; /// Next free slot while free
+        uint32 generation;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<uint32> denseToSlot_;
+    uint32 freeHead_;
+
+public:
+    SlotTable();
+
+    /// The new element's dense index is size() - 1
+    SlotHandle insert();
+
+    /// Returns the dense index the element had. The element at the last dense index now lives there.
+    size_t erase(SlotHandle handle);
+
+    /// Invalidates every handle. Slots are kept for reuse.
+    void clear();
+
+    void reserve(size_t n);
+
+    bool contains(SlotHandle handle) const
+    {
+        // erase() bumps the generation, so a free slot never matches a handle
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation;
+    }
+
+    size_t denseIndex(SlotHandle handle) const
+    {
+        check(contains(handle));
+        return slots_[handle.index].dense;
+    }
+
+    SlotHandle handleAt(size_t dense) const
+    {
+        check(dense < denseToSlot_.size());
+        SlotHandle handle;
+        handle.index = denseToSlot_[dense];
+        handle.generation = slots_[handle.index].generation;
+        return handle;
+    }
+
+    size_t size() const { return denseToSlot_.size(); }
+    bool empty() const { return denseToSlot_.empty(); }
+};
+
+/// Removes v[i] by moving the last element into it
+template <class Vector>
+void swapRemove(Vector& v, size_t i)
+{
+    check(i < v.size());
+    if (i + 1 != v.size())
+    {
+        v[i] = std::move(v.back());
+    }
+    v.pop_back();
+}
+
+/// Values in a dense array addressed by generational handles. Insert and erase are O(1); erase does not keep order.
+template <class T>
+class SlotMap
+{
+public:
+    using Iterator = typename std::vector<T>::iterator;
+    using CIterator = typename std::vector<T>::const_iterator;
+
+private:
+    SlotTable table_;
+    std::vector<T> values_;
+
+public:
+    template <class... Args>
+    SlotHandle emplace(Args&&... args)
+    {
+        values_.emplace_back(std::forward<Args>(args)...);
+        try
+        {
+            return table_.insert();
+        }
+        catch (...)
+        {
+            values_.pop_back();
+            throw;
+        }
+    }
+
+    SlotHandle insert(const T& val) { return emplace(val); }
+    SlotHandle insert(T&& val)      { return emplace(std::move(val)); }
+
+    /// Does nothing for a stale handle
+    void erase(SlotHandle handle)
+    {
+        if (table_.contains(handle))
+        {
+            swapRemove(values_, table_.erase(handle));
+        }
+    }
+
+    void clear()
+    {
+        table_.clear();
+        values_.clear();
+    }
+
+    void reserve(size_t n)
+    {
+        table_.reserve(n);
+        values_.reserve(n);
+    }
+
+    bool contains(SlotHandle handle) const { return table_.contains(handle); }
+
+    /// nullptr for a stale handle
+    T* find(SlotHandle handle)              { return table_.contains(handle) ? &values_[table_.denseIndex(handle)] : nullptr; }
+    const T* find(SlotHandle handle) const  { return table_.contains(handle) ? &values_[table_.denseIndex(handle)] : nullptr; }
+
+    T& operator[](SlotHandle handle)                { return values_[table_.denseIndex(handle)]; }
+    const T& operator[](SlotHandle handle) const    { return values_[table_.denseIndex(handle)]; }
+
+    /// Handle of the element at a dense position
+    SlotHandle handleAt(size_t dense) const { return table_.handleAt(dense); }
+
+    Iterator begin()    noexcept { return values_.begin(); }
+    Iterator end()      noexcept { return values_.end(); }
+    CIterator begin()   const noexcept { return values_.begin(); }
+    CIterator end()     const noexcept { return values_.end(); }
+    CIterator cbegin()  const noexcept { return values_.cbegin(); }
+    CIterator cend()    const noexcept { return values_.cend(); }
+
+    T* data()               noexcept { return values_.data(); }
+    const T* data()         const noexcept { return values_.data(); }
+    size_t size()           const noexcept { return values_.size(); }
+    bool empty()            const noexcept { return values_.empty(); }
+};
+
+GF_NAMESPACE_END
+
+namespace std
+{
+    template <>
+    struct hash<GF_NAMESPACE::SlotHandle>
+    {
+        size_t operator ()(GF_NAMESPACE::SlotHandle h) const noexcept
+        {
+            return std::hash<GF_NAMESPACE::uint64>()((static_cast<GF_NAMESPACE::uint64>(h.generation) << 32) | h.index);
+        }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,442 @@
+#ifndef GAMEFRIENDS_SMALLVECTOR_H
+#define GAMEFRIENDS_SMALLVECTOR_H
+
+#include "exception.h"
+#include "prerequest.h"
+#include <initializer_list>
+#include <iterator>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <new>
+#include <cstddef>
+#include <stdexcept>
+
+GF_NAMESPACE_BEGIN
+
+/// Vector storing up to N elements inline, spilling to the heap beyond that.
+/// Unlike std::vector, moving a SmallVector that is still inline moves its elements, so iterators do not survive a move.
+template <class T, size_t N>
+class SmallVector
+{
+    static_assert(N > 0, "Inline capacity needs be at least 1");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned elements are not supported");
+
+public:
+    using Iterator = T*;
+    using CIterator = const T*;
+    using RIterator = std::reverse_iterator<Iterator>;
+    using CRIterator = std::reverse_iterator<CIterator>;
+
+    using value_type = T;
+    using iterator = Iterator;
+    using const_iterator = CIterator;
+
+private:
+    T* data_;
+    size_t size_;
+    size_t capacity_;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type inline_;
+
+public:
+    SmallVector() noexcept
+        : data_(inlineData())
+        , size_(0)
+        , capacity_(N)
+    {
+    }
+
+    explicit SmallVector(size_t n, const T& val = T())
+        : SmallVector()
+    {
+        assign(n, val);
+    }
+
+    template <class InputIterator, class = typename std::iterator_traits<InputIterator>::iterator_category>
+    SmallVector(InputIterator first, InputIterator last)
+        : SmallVector()
+    {
+        assign(first, last);
+    }
+
+    SmallVector(std::initializer_list<T> il)
+        : SmallVector(std::cbegin(il), std::cend(il))
+    {
+    }
+
+    SmallVector(const SmallVector& x)
+        : SmallVector(std::cbegin(x), std::cend(x))
+    {
+    }
+
+    SmallVector(SmallVector&& x) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : SmallVector()
+    {
+        moveFrom(x);
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        deallocate();
+    }
+
+    SmallVector& operator= (const SmallVector& x)
+    {
+        if (this != &x)
+        {
+            assign(std::cbegin(x), std::cend(x));
+        }
+        return *this;
+    }
+
+    SmallVector& operator= (SmallVector&& x) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &x)
+        {
+            clear();
+            deallocate();
+            data_ = inlineData();
+            capacity_ = N;
+            moveFrom(x);
+        }
+        return *this;
+    }
+
+    SmallVector& operator= (std::initializer_list<T> il)
+    {
+        assign(std::cbegin(il), std::cend(il));
+        return *this;
+    }
+
+    Iterator begin()    noexcept { return data_; }
+    Iterator end()      noexcept { return data_ + size_; }
+    CIterator begin()   const noexcept { return data_; }
+    CIterator end()     const noexcept { return data_ + size_; }
+
+    RIterator rbegin()  noexcept { return RIterator(end()); }
+    RIterator rend()    noexcept { return RIterator(begin()); }
+    CRIterator rbegin() const noexcept { return CRIterator(end()); }
+    CRIterator rend()   const noexcept { return CRIterator(begin()); }
+
+    CIterator cbegin()      const noexcept { return begin(); }
+    CIterator cend()        const noexcept { return end(); }
+    CRIterator crbegin()    const noexcept { return rbegin(); }
+    CRIterator crend()      const noexcept { return rend(); }
+
+    size_t size()       const noexcept { return size_; }
+    size_t maxSize()    const noexcept { return static_cast<size_t>(-1) / sizeof(T); }
+    size_t capacity()   const noexcept { return capacity_; }
+    bool empty()        const noexcept { return size_ == 0; }
+
+    /// True while the elements live in the inline storage
+    bool isInline()     const noexcept { return data_ == inlineData(); }
+
+    T& operator[](size_t n)         { check(n < size_); return data_[n]; }
+    const T& operator[](size_t n)   const { check(n < size_); return data_[n]; }
+    T& at(size_t n)                 { enforce<std::out_of_range>(n < size_, "SmallVector index out of range."); return data_[n]; }
+    const T& at(size_t n)           const { enforce<std::out_of_range>(n < size_, "SmallVector index out of range."); return data_[n]; }
+    T& front()          { check(size_ > 0); return data_[0]; }
+    const T& front()    const { check(size_ > 0); return data_[0]; }
+    T& back()           { check(size_ > 0); return data_[size_ - 1]; }
+    const T& back()     const { check(size_ > 0); return data_[size_ - 1]; }
+    T* data()           noexcept { return data_; }
+    const T* data()     const noexcept { return data_; }
+
+    void reserve(size_t n)
+    {
+        if (n > capacity_)
+        {
+            reallocate(n);
+        }
+    }
+
+    /// Returns to the inline storage when the elements fit
+    void shrink()
+    {
+        if (!isInline() && size_ < capacity_)
+        {
+            reallocate(size_);
+        }
+    }
+
+    void assign(size_t n, const T& val)
+    {
+        clear();
+        reserve(n);
+        std::uninitialized_fill_n(data_, n, val);
+        size_ = n;
+    }
+
+    template <class InputIterator, class = typename std::iterator_traits<InputIterator>::iterator_category>
+    void assign(InputIterator first, InputIterator last)
+    {
+        clear();
+        append(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    void assign(std::initializer_list<T> il)
+    {
+        assign(std::cbegin(il), std::cend(il));
+    }
+
+    template <class... Args>
+    T& emplaceBack(Args&&... args)
+    {
+        if (size_ == capacity_)
+        {
+            // Construct before moving the old elements, args may refer to one of them
+            const auto newCapacity = grownCapacity(size_ + 1);
+            const auto p = allocate(newCapacity);
+            try
+            {
+                new (p + size_) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                ::operator delete(p);
+                throw;
+            }
+            relocate(p, newCapacity);
+        }
+        else
+        {
+            new (data_ + size_) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void pushBack(const T& val) { emplaceBack(val); }
+    void pushBack(T&& val)      { emplaceBack(std::move(val)); }
+
+    void popBack()
+    {
+        check(size_ > 0);
+        data_[--size_].~T();
+    }
+
+    template <class... Args>
+    Iterator emplace(CIterator pos, Args&&... args)
+    {
+        const auto index = static_cast<size_t>(pos - data_);
+        check(index <= size_);
+        emplaceBack(std::forward<Args>(args)...);
+        std::rotate(data_ + index, data_ + size_ - 1, data_ + size_);
+        return data_ + index;
+    }
+
+    Iterator insert(CIterator pos, const T& val)    { return emplace(pos, val); }
+    Iterator insert(CIterator pos, T&& val)         { return emplace(pos, std::move(val)); }
+
+    template <class InputIterator, class = typename std::iterator_traits<InputIterator>::iterator_category>
+    Iterator insert(CIterator pos, InputIterator first, InputIterator last)
+    {
+        const auto index = static_cast<size_t>(pos - data_);
+        check(index <= size_);
+        const auto oldSize = size_;
+        append(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+        std::rotate(data_ + index, data_ + oldSize, data_ + size_);
+        return data_ + index;
+    }
+
+    Iterator erase(CIterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    Iterator erase(CIterator first, CIterator last)
+    {
+        const auto f = data_ + (first - data_);
+        const auto l = data_ + (last - data_);
+        check(data_ <= f && f <= l && l <= data_ + size_);
+        const auto newEnd = std::move(l, end(), f);
+        destroy(newEnd, end());
+        size_ = static_cast<size_t>(newEnd - data_);
+        return f;
+    }
+
+    void resize(size_t n)
+    {
+        resizeImpl(n, [](T* p) { new (p) T(); });
+    }
+
+    void resize(size_t n, const T& val)
+    {
+        resizeImpl(n, [&val](T* p) { new (p) T(val); });
+    }
+
+    void clear() noexcept
+    {
+        destroy(begin(), end());
+        size_ = 0;
+    }
+
+    void swap(SmallVector& x)
+    {
+        SmallVector tmp(std::move(x));
+        x = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    T* inlineData() noexcept
+    {
+        return reinterpret_cast<T*>(&inline_);
+    }
+
+    const T* inlineData() const noexcept
+    {
+        return reinterpret_cast<const T*>(&inline_);
+    }
+
+    static T* allocate(size_t n)
+    {
+        if (n > static_cast<size_t>(-1) / sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate() noexcept
+    {
+        if (!isInline())
+        {
+            ::operator delete(data_);
+        }
+    }
+
+    static void destroy(T* first, T* last) noexcept
+    {
+        for (; first != last; ++first)
+        {
+            first->~T();
+        }
+    }
+
+    size_t grownCapacity(size_t required) const
+    {
+        const auto doubled = capacity_ * 2;
+        return doubled > required ? doubled : required;
+    }
+
+    /// Moves the elements to p, which has room for newCapacity, and adopts it
+    void relocate(T* p, size_t newCapacity)
+    {
+        for (size_t i = 0; i < size_; ++i)
+        {
+            new (p + i) T(std::move_if_noexcept(data_[i]));
+            data_[i].~T();
+        }
+        deallocate();
+        data_ = p;
+        capacity_ = newCapacity;
+    }
+
+    void reallocate(size_t newCapacity)
+    {
+        if (newCapacity <= N)
+        {
+            if (!isInline())
+            {
+                const auto heap = data_;
+                data_ = inlineData();
+                capacity_ = N;
+                for (size_t i = 0; i < size_; ++i)
+                {
+                    new (data_ + i) T(std::move_if_noexcept(heap[i]));
+                    heap[i].~T();
+                }
+                ::operator delete(heap);
+            }
+            return;
+        }
+        relocate(allocate(newCapacity), newCapacity);
+    }
+
+    void moveFrom(SmallVector& x)
+    {
+        if (x.isInline())
+        {
+            for (size_t i = 0; i < x.size_; ++i)
+            {
+                new (data_ + i) T(std::move(x.data_[i]));
+            }
+            size_ = x.size_;
+            x.clear();
+        }
+        else
+        {
+            data_ = x.data_;
+            size_ = x.size_;
+            capacity_ = x.capacity_;
+            x.data_ = x.inlineData();
+            x.size_ = 0;
+            x.capacity_ = N;
+        }
+    }
+
+    template <class InputIterator>
+    void append(InputIterator first, InputIterator last, std::input_iterator_tag)
+    {
+        for (; first != last; ++first)
+        {
+            emplaceBack(*first);
+        }
+    }
+
+    template <class ForwardIterator>
+    void append(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+    {
+        const auto n = static_cast<size_t>(std::distance(first, last));
+        if (size_ + n > capacity_)
+        {
+            reallocate(grownCapacity(size_ + n));
+        }
+        std::uninitialized_copy(first, last, data_ + size_);
+        size_ += n;
+    }
+
+    template <class Construct>
+    void resizeImpl(size_t n, Construct construct)
+    {
+        if (n < size_)
+        {
+            destroy(data_ + n, end());
+            size_ = n;
+            return;
+        }
+
+        reserve(n);
+        for (; size_ < n; ++size_)
+        {
+            construct(data_ + size_);
+        }
+    }
+};
+
+template <class T, size_t N>
+bool operator ==(const SmallVector<T, N>& a, const SmallVector<T, N>& b)
+{
+    return a.size() == b.size() && std::equal(std::cbegin(a), std::cend(a), std::cbegin(b));
+}
+
+template <class T, size_t N>
+bool operator !=(const SmallVector<T, N>& a, const SmallVector<T, N>& b)
+{
+    return !(a == b);
+}
+
+GF_NAMESPACE_END
+
+namespace std
+{
+    template <class T, size_t N>
+    void swap(GF_NAMESPACE::SmallVector<T, N>& a, GF_NAMESPACE::SmallVector<T, N>& b)
+    {
+        a.swap(b);
+    }
+}
+
+#endif
\ No newline at end of file
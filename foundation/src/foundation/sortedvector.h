@@ -40,7 +40,7 @@ public:
         : vec_(n, val, alloc)
         , comp_(comp)
     {
-        std::sort(std::cbegin(vec_), std::cend(vec_), comp_);
+        std::sort(std::begin(vec_), std::end(vec_), comp_);
     }
 
     SortedVector(size_t n, const T& val = T(), const Alloc& alloc = Alloc())
@@ -53,7 +53,7 @@ public:
         : vec_(first, last, alloc)
         , comp_(comp)
     {
-        std::sort(std::cbegin(vec_), std::cend(vec_), comp_);
+        std::sort(std::begin(vec_), std::end(vec_), comp_);
     }
 
     template <class InputIterator>
@@ -82,7 +82,7 @@ public:
         : vec_(il, alloc)
         , comp_(comp)
     {
-        std::sort(std::cbegin(vec_), std::cend(vec_), comp_);
+        std::sort(std::begin(vec_), std::end(vec_), comp_);
     }
 
     SortedVector(std::initializer_list<T> il, const Alloc& alloc = Alloc())
@@ -96,7 +96,8 @@ public:
     SortedVector& operator= (SortedVector&& x) = default;
     SortedVector& operator= (std::initializer_list<T> il)
     {
-        SortedVector(il).swap(*this);
+        SortedVector(il, comp_, allocator()).swap(*this);
+        return *this;
     }
 
     Iterator begin()    noexcept { return vec_.begin(); }
@@ -148,33 +149,143 @@ public:
         SortedVector(il).swap(*this);
     }
 
-    Iterator insert(const T& val)           { return vec_.insert(std::upper_bound(std::cbegin(vec_), std::cend(vec_), val, comp_), val); }
-    Iterator insert(T&& val)                { return vec_.insert(std::upper_bound(std::cbegin(vec_), std::cend(vec_), val, comp_), std::move(val)); }
-    Iterator insert(size_t n, const T& val) { return vec_.insert(std::upper_bound(std::cbegin(vec_), std::cend(vec_), val, comp_), n, val); }
+    Iterator insert(const T& val)           { return vec_.insert(upperBound(val), val); }
+    Iterator insert(T&& val)                { return vec_.insert(upperBound(val), std::move(val)); }
+    Iterator insert(size_t n, const T& val) { return vec_.insert(upperBound(val), n, val); }
+
+    /// Inserts at hint when the order allows it, otherwise same as insert(val)
+    Iterator insert(CIterator hint, const T& val)   { return vec_.insert(checkHint(hint, val), val); }
+    Iterator insert(CIterator hint, T&& val)        { return vec_.insert(checkHint(hint, val), std::move(val)); }
 
+    /// Appends, sorts only the new tail and merges it: O(n + m log m)
     template <class InputIterator>
     void insert(InputIterator first, InputIterator last)
     {
-        check(last - first >= 0);
-        vec_.reserve(vec_.size() + (last - first));
-        while (first != last)
+        const auto n = vec_.size();
+        vec_.insert(std::end(vec_), first, last);
+        mergeTail(n);
+    }
+
+    void insert(std::initializer_list<T> il) { insert(std::cbegin(il), std::cend(il)); }
+
+    template <class... Args>
+    Iterator emplace(Args&&... args)
+    {
+        return insert(T(std::forward<Args>(args)...));
+    }
+
+    /// Inserts only if no equivalent element exists
+    std::pair<Iterator, bool> insertUnique(const T& val)
+    {
+        const auto it = lowerBound(val);
+        if (it != std::end(vec_) && !comp_(val, *it))
         {
-            insert(*first);
-            ++first;
+            return{ it, false };
         }
-        std::sort(std::cbegin(vec_), std::cend(vec_), comp_);
+        return{ vec_.insert(it, val), true };
     }
 
-    void insert(std::initializer_list<T> il) { insert(std::cbegin(il), std::cend(il)); }
+    std::pair<Iterator, bool> insertUnique(T&& val)
+    {
+        const auto it = lowerBound(val);
+        if (it != std::end(vec_) && !comp_(val, *it))
+        {
+            return{ it, false };
+        }
+        return{ vec_.insert(it, std::move(val)), true };
+    }
+
+    /// Existing elements win over equivalent new ones, and the first of equivalent new ones wins.
+    /// Equivalent elements already present are all kept.
+    template <class InputIterator>
+    void insertUnique(InputIterator first, InputIterator last)
+    {
+        const auto n = vec_.size();
+        vec_.insert(std::end(vec_), first, last);
+
+        const auto mid = std::begin(vec_) + n;
+        std::stable_sort(mid, std::end(vec_), comp_);
+        auto tailEnd = std::unique(mid, std::end(vec_), [this](const T& a, const T& b) { return !comp_(a, b); });
+        tailEnd = std::remove_if(mid, tailEnd, [this, n](const T& val)
+        {
+            const auto existingEnd = std::cbegin(vec_) + n;
+            const auto it = std::lower_bound(std::cbegin(vec_), existingEnd, val, comp_);
+            return it != existingEnd && !comp_(val, *it);
+        });
+        vec_.erase(tailEnd, std::end(vec_));
+        std::inplace_merge(std::begin(vec_), std::begin(vec_) + n, std::end(vec_), comp_);
+    }
+
+    template <class... Args>
+    std::pair<Iterator, bool> emplaceUnique(Args&&... args)
+    {
+        return insertUnique(T(std::forward<Args>(args)...));
+    }
+
+    /// Key may be any type the comparator accepts on both sides
+    template <class Key>
+    Iterator lowerBound(const Key& key) { return std::lower_bound(std::begin(vec_), std::end(vec_), key, comp_); }
+    template <class Key>
+    CIterator lowerBound(const Key& key) const { return std::lower_bound(std::cbegin(vec_), std::cend(vec_), key, comp_); }
+    template <class Key>
+    Iterator upperBound(const Key& key) { return std::upper_bound(std::begin(vec_), std::end(vec_), key, comp_); }
+    template <class Key>
+    CIterator upperBound(const Key& key) const { return std::upper_bound(std::cbegin(vec_), std::cend(vec_), key, comp_); }
+    template <class Key>
+    std::pair<Iterator, Iterator> equalRange(const Key& key) { return std::equal_range(std::begin(vec_), std::end(vec_), key, comp_); }
+    template <class Key>
+    std::pair<CIterator, CIterator> equalRange(const Key& key) const { return std::equal_range(std::cbegin(vec_), std::cend(vec_), key, comp_); }
+
+    template <class Key>
+    Iterator find(const Key& key)
+    {
+        const auto it = lowerBound(key);
+        return it != std::end(vec_) && !comp_(key, *it) ? it : std::end(vec_);
+    }
+
+    template <class Key>
+    CIterator find(const Key& key) const
+    {
+        const auto it = lowerBound(key);
+        return it != std::cend(vec_) && !comp_(key, *it) ? it : std::cend(vec_);
+    }
+
+    template <class Key>
+    bool contains(const Key& key) const { return find(key) != std::cend(vec_); }
 
     Iterator erase(CIterator pos)                   { return vec_.erase(pos); }
     Iterator erase(CIterator first, CIterator last) { return vec_.erase(first, last); }
 
+    /// Removes all elements equivalent to val and returns the count
+    size_t erase(const T& val)
+    {
+        const auto r = equalRange(val);
+        const auto n = r.second - r.first;
+        vec_.erase(r.first, r.second);
+        return n;
+    }
+
     void swap(SortedVector& x) { vec_.swap(x.vec_); std::swap(comp_, x.comp_); }
     void clear() noexcept { vec_.clear(); }
 
     Comp comp() const { return comp_; }
     Alloc allocator() const noexcept { return vec_.get_allocator(); }
+
+private:
+    void mergeTail(size_t n)
+    {
+        const auto mid = std::begin(vec_) + n;
+        std::sort(mid, std::end(vec_), comp_);
+        std::inplace_merge(std::begin(vec_), mid, std::end(vec_), comp_);
+    }
+
+    CIterator checkHint(CIterator hint, const T& val) const
+    {
+        const auto ordered =
+            (hint == std::cbegin(vec_) || !comp_(val, *(hint - 1))) &&
+            (hint == std::cend(vec_) || !comp_(*hint, val));
+        return ordered ? hint : upperBound(val);
+    }
 };
 
 GF_NAMESPACE_END
@@ -0,0 +1,196 @@
+#ifndef GAMEFRIENDS_SPSCQUEUE_H
+#define GAMEFRIENDS_SPSCQUEUE_H
+
+#include "queuewait.h"
+#include "prerequest.h"
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <new>
+
+GF_NAMESPACE_BEGIN
+
+/// Bounded single producer, single consumer ring queue.
+/// Each side caches the other side's index, so the shared indices are only read when the cache says full or empty.
+template <class T>
+class SpscQueue
+{
+private:
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    const size_t mask_;
+    const std::unique_ptr<Slot[]> slots_;
+    char pad0_[detail::CACHE_LINE_SIZE];
+
+    // Producer
+    std::atomic<size_t> tail_;
+    size_t headCache_;
+    char pad1_[detail::CACHE_LINE_SIZE - sizeof(size_t) * 2];
+
+    // Consumer
+    std::atomic<size_t> head_;
+    size_t tailCache_;
+    char pad2_[detail::CACHE_LINE_SIZE - sizeof(size_t) * 2];
+
+    detail::QueueWait notEmpty_;
+    detail::QueueWait notFull_;
+
+public:
+    /// capacity is rounded up to a 2-power. Throws std::length_error above detail::MAX_QUEUE_CAPACITY.
+    explicit SpscQueue(size_t capacity)
+        : mask_(detail::queueCapacity(capacity) - 1)
+        , slots_(new Slot[mask_ + 1])
+        , tail_(0)
+        , headCache_(0)
+        , head_(0)
+        , tailCache_(0)
+    {
+    }
+
+    ~SpscQueue()
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        for (auto i = head_.load(std::memory_order_relaxed); i != tail; ++i)
+        {
+            reinterpret_cast<T&>(slots_[i & mask_]).~T();
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator =(const SpscQueue&) = delete;
+
+    size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    /// Approximate when the other side is active
+    size_t size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /// Producer only
+    template <class... Args>
+    bool tryEmplace(Args&&... args)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ > mask_)
+        {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ > mask_)
+            {
+                return false;
+            }
+        }
+
+        new (&slots_[tail & mask_]) T(std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        notEmpty_.notify();
+        return true;
+    }
+
+    bool tryPush(const T& val)
+    {
+        return tryEmplace(val);
+    }
+
+    bool tryPush(T&& val)
+    {
+        return tryEmplace(std::move(val));
+    }
+
+    /// Producer only. Pushes as many of [first, first + n) as fit with one publish; returns the count.
+    template <class InputIterator>
+    size_t tryPushBulk(InputIterator first, size_t n)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        auto space = capacity() - (tail - headCache_);
+        if (space < n)
+        {
+            headCache_ = head_.load(std::memory_order_acquire);
+            space = capacity() - (tail - headCache_);
+        }
+
+        const auto count = n < space ? n : space;
+        for (size_t i = 0; i < count; ++i, ++first)
+        {
+            new (&slots_[(tail + i) & mask_]) T(*first);
+        }
+
+        if (count > 0)
+        {
+            tail_.store(tail + count, std::memory_order_release);
+            notEmpty_.notify();
+        }
+        return count;
+    }
+
+    /// Consumer only
+    bool tryPop(T& out)
+    {
+        return tryPopImpl(&out, 1) == 1;
+    }
+
+    /// Consumer only. Pops up to n elements into out with one release; returns the count.
+    template <class OutputIterator>
+    size_t tryPopBulk(OutputIterator out, size_t n)
+    {
+        return tryPopImpl(out, n);
+    }
+
+    /// Producer only. Blocks while full.
+    void push(T val)
+    {
+        while (!tryPush(std::move(val)))
+        {
+            notFull_.wait([this] { return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire) <= mask_; });
+        }
+    }
+
+    /// Consumer only. Blocks while empty.
+    void pop(T& out)
+    {
+        while (!tryPop(out))
+        {
+            notEmpty_.wait([this] { return tail_.load(std::memory_order_acquire) != head_.load(std::memory_order_relaxed); });
+        }
+    }
+
+private:
+    template <class OutputIterator>
+    size_t tryPopImpl(OutputIterator out, size_t n)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (tailCache_ - head < n)
+        {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+        }
+
+        const auto available = tailCache_ - head;
+        const auto count = n < available ? n : available;
+        for (size_t i = 0; i < count; ++i, ++out)
+        {
+            auto& slot = reinterpret_cast<T&>(slots_[(head + i) & mask_]);
+            *out = std::move(slot);
+            slot.~T();
+        }
+
+        if (count > 0)
+        {
+            head_.store(head + count, std::memory_order_release);
+            notFull_.notify();
+        }
+        return count;
+    }
+};
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
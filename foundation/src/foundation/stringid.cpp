@@ -0,0 +1,77 @@
+#include "stringid.h"
+#include "hashmap.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+GF_NAMESPACE_BEGIN
+
+namespace
+{
+    struct Registry
+    {
+        std::mutex mutex;
+        std::deque<std::string> strings; /// Stable addresses
+        HashMap<uint64, const std::string*> table;
+    };
+
+    Registry& registry()
+    {
+        static Registry r;
+        return r;
+    }
+
+    /// The part that is hashed, like literals everything from the first NUL is ignored
+    StringRef hashedPart(StringRef s) noexcept
+    {
+        const auto end = std::find(std::begin(s), std::end(s), '\0');
+        return StringRef(s.data(), static_cast<size_t>(end - std::begin(s)));
+    }
+
+    uint64 fnv1a(StringRef s) noexcept
+    {
+        auto h = detail::FNV_OFFSET;
+        for (const auto c : s)
+        {
+            h = (h ^ static_cast<uint8>(c)) * detail::FNV_PRIME;
+        }
+        return h;
+    }
+}
+
+StringId::StringId(StringRef s) noexcept
+    : hash_(fnv1a(hashedPart(s)))
+{
+}
+
+StringId StringId::intern(StringRef s)
+{
+    s = hashedPart(s);
+    const StringId id(s);
+
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    const auto found = r.table.find(id.hash_);
+    if (found != std::end(r.table))
+    {
+        enforce<StringIdCollision>(StringRef(*found->second) == s,
+            "StringId collision: \"" + *found->second + "\" and \"" + s.str() + "\".");
+        return id;
+    }
+
+    r.strings.emplace_back(s.data(), s.size());
+    r.table.emplace(id.hash_, &r.strings.back());
+    return id;
+}
+
+const char* StringId::name() const
+{
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    const auto found = r.table.find(hash_);
+    return found != std::end(r.table) ? found->second->c_str() : nullptr;
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef GAMEFRIENDS_STRINGID_H
+#define GAMEFRIENDS_STRINGID_H
+
+#include "stringref.h"
+#include "exception.h"
+#include "prerequest.h"
+#include <string>
+#include <functional>
+
+GF_NAMESPACE_BEGIN
+
+class StringIdCollision : public Error
+{
+public:
+    explicit StringIdCollision(const std::string& msg)
+        : Error(msg) {}
+};
+
+namespace detail
+{
+    constexpr uint64 FNV_OFFSET = 14695981039346656037ull;
+    constexpr uint64 FNV_PRIME = 1099511628211ull;
+
+    /// FNV-1a, stops at n or NUL
+    constexpr uint64 fnv1a(const char* s, size_t n, uint64 h = FNV_OFFSET)
+    {
+        return n == 0 || *s == '\0' ? h : fnv1a(s + 1, n - 1, (h ^ static_cast<uint8>(*s)) * FNV_PRIME);
+    }
+}
+
+/// 64-bit name hash, compared and hashed as an integer.
+/// Literals hash at compile time; intern() additionally records the string for name() and
+/// throws StringIdCollision if a different string already has the same hash.
+class StringId
+{
+private:
+    uint64 hash_;
+
+public:
+    constexpr StringId() noexcept
+        : hash_(detail::FNV_OFFSET)
+    {
+    }
+
+    template <size_t N>
+    constexpr explicit StringId(const char (&s)[N]) noexcept
+        : hash_(detail::fnv1a(s, N - 1))
+    {
+    }
+
+    /// Hash only, the string is not recorded
+    explicit StringId(StringRef s) noexcept;
+
+    static StringId intern(StringRef s) noexcept(false);
+
+    constexpr uint64 hash() const noexcept { return hash_; }
+
+    /// The interned string, or nullptr if it was never interned. Valid until shutdown.
+    const char* name() const;
+};
+
+constexpr bool operator ==(StringId a, StringId b) noexcept { return a.hash() == b.hash(); }
+constexpr bool operator !=(StringId a, StringId b) noexcept { return a.hash() != b.hash(); }
+constexpr bool operator <(StringId a, StringId b) noexcept { return a.hash() < b.hash(); }
+
+GF_NAMESPACE_END
+
+namespace std
+{
+    template <>
+    struct hash<GF_NAMESPACE::StringId>
+    {
+        size_t operator ()(GF_NAMESPACE::StringId id) const noexcept
+        {
+            return static_cast<size_t>(id.hash());
+        }
+    };
+}
+
+#endif
\ No newline at end of file
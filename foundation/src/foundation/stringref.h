@@ -0,0 +1,70 @@
+#ifndef GAMEFRIENDS_STRINGREF_H
+#define GAMEFRIENDS_STRINGREF_H
+
+#include "prerequest.h"
+#include <string>
+#include <cstring>
+#include <algorithm>
+
+GF_NAMESPACE_BEGIN
+
+/// Non-owning view of a char range. The referenced string must outlive it.
+class StringRef
+{
+private:
+    const char* p_;
+    size_t n_;
+
+public:
+    constexpr StringRef() noexcept
+        : p_("")
+        , n_(0)
+    {
+    }
+
+    constexpr StringRef(const char* p, size_t n) noexcept
+        : p_(p)
+        , n_(n)
+    {
+    }
+
+    StringRef(const char* s) noexcept
+        : p_(s)
+        , n_(std::strlen(s))
+    {
+    }
+
+    StringRef(const std::string& s) noexcept
+        : p_(s.data())
+        , n_(s.size())
+    {
+    }
+
+    constexpr const char* data() const noexcept { return p_; }
+    constexpr size_t size() const noexcept { return n_; }
+    constexpr bool empty() const noexcept { return n_ == 0; }
+    constexpr const char* begin() const noexcept { return p_; }
+    constexpr const char* end() const noexcept { return p_ + n_; }
+    constexpr char operator [](size_t i) const { return p_[i]; }
+
+    std::string str() const { return std::string(p_, n_); }
+    explicit operator std::string() const { return str(); }
+
+    int compare(StringRef s) const noexcept
+    {
+        const auto r = std::memcmp(p_, s.p_, std::min(n_, s.n_));
+        return r != 0 ? r : (n_ < s.n_ ? -1 : (n_ > s.n_ ? 1 : 0));
+    }
+};
+
+inline bool operator ==(StringRef a, StringRef b) noexcept
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+}
+
+inline bool operator !=(StringRef a, StringRef b) noexcept { return !(a == b); }
+inline bool operator <(StringRef a, StringRef b) noexcept { return a.compare(b) < 0; }
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -1,148 +1,214 @@
 #include "uri.h"
-#include "string.h"
+#include <cctype>
 
 GF_NAMESPACE_BEGIN
 
-bool Uri::isAbsolute(const std::string& path)
+namespace
 {
-    if (!path.empty())
+    bool isSeparator(char c)
     {
-        if (path[0] == '/' || path[0] == '\\')
-        {
-            return true;
-        }
-        if (path.length() >= 2 && tolower(path[0]) >= 'a' && tolower(path[0]) <= 'z' && path[1] == ':')
-        {
-            return true;
-        }
+        return c == '/' || c == '\\';
     }
-    return false;
-}
 
-std::string Uri::uniform(const std::string& path)
-{
-    if (path.empty())
+    bool isDrive(StringRef path)
     {
-        return "";
+        return path.size() >= 2 && std::isalpha(static_cast<unsigned char>(path[0])) && path[1] == ':';
     }
 
-    auto s = tolowers(path);
-    for (auto p = s.find("\\"); p != std::string::npos; p = s.find("\\", p + 1))
+    char lower(char c)
     {
-        s.replace(p, 1, "/");
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
     }
-    for (auto p = s.find("//"); p != std::string::npos; p = s.find("//", p))
+
+    std::string join(StringRef a, StringRef b)
     {
-        s.replace(p, 1, "/");
+        std::string s;
+        s.reserve(a.size() + 1 + b.size());
+        s.append(a.data(), a.size());
+        s += '/';
+        s.append(b.data(), b.size());
+        return s;
     }
 
-    std::string prefix;
-    if (isAbsolute(path))
+    /// Character of s with a virtual '/' appended unless s already ends with one
+    char slashed(const char* s, size_t n, size_t i)
     {
-        if (path[0] == '/')
-        {
-            prefix = "/";
-            s.erase(0, 1);
-        }
-        else
-        {
-            prefix = s.substr(0, 3);
-            s.erase(0, 3);
-        }
+        return i < n ? s[i] : '/';
     }
 
-    auto p = s.rfind('/');
-    if (p == std::string::npos)
+    size_t slashedLength(const char* s, size_t n)
     {
-        p = 0;
+        return n > 0 && s[n - 1] != '/' ? n + 1 : n;
     }
-    else
+}
+
+bool Uri::isAbsolute(StringRef path)
+{
+    return (!path.empty() && isSeparator(path[0])) || isDrive(path);
+}
+
+size_t Uri::uniform(StringRef path, char* out)
+{
+    // Writes never overtake reads, so out may alias path
+    auto p = path.begin();
+    const auto end = path.end();
+    size_t n = 0;
+
+    // Root ("/", "c:" or "c:/") is kept as is
+    if (p != end && isSeparator(*p))
     {
-        p += 1;
+        out[n++] = '/';
+        ++p;
+    }
+    else if (isDrive(path))
+    {
+        out[n++] = lower(p[0]);
+        out[n++] = ':';
+        p += 2;
+        if (p != end && isSeparator(*p))
+        {
+            out[n++] = '/';
+            ++p;
+        }
     }
 
-    size_t back = 0;
-    while (p > 0)
+    const auto root = n;
+    auto floor = n; /// End of the leading "../" run that can not be resolved
+
+    while (p != end)
     {
-        auto q = s.rfind('/', p - 2);
-        if (q == std::string::npos)
+        while (p != end && isSeparator(*p))
         {
-            q = 0;
+            ++p;
         }
-        else
+        const auto seg = p;
+        while (p != end && !isSeparator(*p))
         {
-            q += 1;
+            ++p;
         }
 
-        if (s[q] == '.' && s[q + 1] == '/')
+        const auto len = static_cast<size_t>(p - seg);
+        if (len == 0 || (len == 1 && seg[0] == '.'))
         {
-            s.erase(q, 2);
+            continue;
         }
-        else if (s.length() - q >= 3 && s[q] == '.' && s[q + 1] == '.' && s[q + 2] == '/')
+
+        if (len == 2 && seg[0] == '.' && seg[1] == '.')
         {
-            ++back;
+            if (n > floor)
+            {
+                // Drop the last segment with its separator
+                while (n > floor && out[n - 1] != '/')
+                {
+                    --n;
+                }
+                if (n > floor)
+                {
+                    --n;
+                }
+            }
+            else if (root == 0)
+            {
+                if (n > 0)
+                {
+                    out[n++] = '/';
+                }
+                out[n++] = '.';
+                out[n++] = '.';
+                floor = n;
+            }
+            continue;
         }
-        else if (back > 0)
+
+        if (n > root)
         {
-            s.erase(q, p - q + 2);
-            --back;
+            out[n++] = '/';
+        }
+        for (auto c = seg; c != p; ++c)
+        {
+            out[n++] = lower(*c);
         }
-
-        p = q;
-    }
-
-    if (s.length() != back * 3 && !s.empty() && s.back() == '/')
-    {
-        s.pop_back();
     }
 
-    if (!prefix.empty())
-    {
-        s.erase(0, back * 3);
-    }
+    return n;
+}
 
-    return prefix + s;
+void Uri::uniform(StringRef path, std::string& out)
+{
+    out.resize(path.size());
+    out.resize(uniform(path, &out[0]));
 }
 
-std::string Uri::cat(const std::string& a, const std::string& b)
+std::string Uri::uniform(StringRef path)
 {
-    return uniform(a + '/' + b);
+    std::string s;
+    uniform(path, s);
+    return s;
 }
 
-std::string Uri::absolutePath(const std::string& absBase, const std::string& relPath)
+std::string Uri::cat(StringRef a, StringRef b)
 {
-    return uniform(absBase + '/' + relPath);
+    auto s = join(a, b);
+    s.resize(uniform(s, &s[0]));
+    return s;
 }
 
-std::string Uri::relativePath(const std::string& absBase, const std::string& absPath)
+std::string Uri::absolutePath(StringRef absBase, StringRef relPath)
 {
-    const auto baseSlash = uniform(absBase) + '/';
-    const auto pathSlash = uniform(absPath) + '/';
+    return cat(absBase, relPath);
+}
 
-    int diffAt = 0;
-    for (size_t p = 0; p < baseSlash.length() && p < pathSlash.length() &&
-        baseSlash[p] == pathSlash[p]; ++p)
+std::string Uri::relativePath(StringRef absBase, StringRef absPath)
+{
+    // Normalize both into one scratch buffer
+    std::string scratch(absBase.size() + absPath.size(), '\0');
+    const auto base = scratch.data();
+    const auto path = scratch.data() + absBase.size();
+    const auto baseLength = uniform(absBase, &scratch[0]);
+    const auto pathLength = uniform(absPath, &scratch[absBase.size()]);
+
+    // Last separator of the common directory prefix
+    const auto baseSlashed = slashedLength(base, baseLength);
+    const auto pathSlashed = slashedLength(path, pathLength);
+
+    size_t common = 0;
+    bool found = false;
+    for (size_t i = 0; i < baseSlashed && i < pathSlashed && slashed(base, baseLength, i) == slashed(path, pathLength, i); ++i)
     {
-        if (baseSlash[p] == '/')
+        if (slashed(base, baseLength, i) == '/')
         {
-            diffAt = p;
+            common = i;
+            found = true;
         }
     }
 
-    int back = 0;
-    for (size_t p = diffAt + 1; p < baseSlash.length(); ++p)
+    // Different roots can not be related
+    if (!found)
     {
-        back += baseSlash[p] == '/';
+        return std::string(path, pathLength);
     }
 
+    size_t back = 0;
+    for (auto i = common + 1; i < baseSlashed; ++i)
+    {
+        back += slashed(base, baseLength, i) == '/';
+    }
+
+    const auto rest = common + 1 < pathLength ? pathLength - common - 1 : 0;
+
     std::string ret;
-    for (int i = 0; i < back; ++i)
+    ret.reserve(back * 3 + rest);
+    for (size_t i = 0; i < back; ++i)
     {
         ret += "../";
     }
-    ret += pathSlash.substr(diffAt + 1);
+    ret.append(path + pathLength - rest, rest);
 
-    return uniform(ret);
+    if (!ret.empty() && ret.back() == '/')
+    {
+        ret.pop_back();
+    }
+    return ret;
 }
 
 GF_NAMESPACE_END
\ No newline at end of file
@@ -1,18 +1,27 @@
 #ifndef GAMEFRIENDS_URI_H
 #define GAMEFRIENDS_URI_H
 
+#include "stringref.h"
 #include "prerequest.h"
 #include <string>
 
 GF_NAMESPACE_BEGIN
 
+/// Paths are normalized to lower case, '/' separated, without "." segments, redundant ".." or a trailing '/'.
 struct Uri
 {
-    static bool isAbsolute(const std::string& path);
-    static std::string uniform(const std::string& path);
-    static std::string cat(const std::string& a, const std::string& b);
-    static std::string absolutePath(const std::string& absBase, const std::string& relPath);
-    static std::string relativePath(const std::string& absBase, const std::string& absPath);
+    static bool isAbsolute(StringRef path);
+
+    /// Single pass normalization into out, which must hold path.size() chars and may alias path.
+    /// Returns the normalized length.
+    static size_t uniform(StringRef path, char* out);
+    /// out must not alias path. Reuses the capacity of out.
+    static void uniform(StringRef path, std::string& out);
+    static std::string uniform(StringRef path);
+
+    static std::string cat(StringRef a, StringRef b);
+    static std::string absolutePath(StringRef absBase, StringRef relPath);
+    static std::string relativePath(StringRef absBase, StringRef absPath);
 };
 
 GF_NAMESPACE_END
@@ -1,7 +1,10 @@
 #ifndef GAMEFRIENDS_VECTOR2_H
 #define GAMEFRIENDS_VECTOR2_H
 
+#include "math.h"
+#include "exception.h"
 #include "prerequest.h"
+#include <cmath>
 
 GF_NAMESPACE_BEGIN
 
@@ -13,7 +16,7 @@ public:
     float x, y;
 
     Vector2() = default;
-    Vector2(float nx, float ny);
+    constexpr Vector2(float nx, float ny);
     Vector2(const Vector2&) = default;
 
     Vector2& operator =(const Vector2&) = default;
@@ -22,7 +25,7 @@ public:
     float& operator [](size_t i);
 
     float norm() const;
-    float dot(const Vector2& v) const;
+    constexpr float dot(const Vector2& v) const;
     Vector3 xyz(float z) const;
 
     void normalize();
@@ -36,13 +39,13 @@ public:
 bool operator ==(const Vector2& a, const Vector2& b);
 bool operator !=(const Vector2& a, const Vector2& b);
 
-const Vector2 operator +(const Vector2& v);
-const Vector2 operator -(const Vector2& v);
+constexpr const Vector2 operator +(const Vector2& v);
+constexpr const Vector2 operator -(const Vector2& v);
 
-const Vector2 operator +(const Vector2& a, const Vector2& b);
-const Vector2 operator -(const Vector2& a, const Vector2& b);
-const Vector2 operator *(const Vector2& v, float k);
-const Vector2 operator *(float k, const Vector2& v);
+constexpr const Vector2 operator +(const Vector2& a, const Vector2& b);
+constexpr const Vector2 operator -(const Vector2& a, const Vector2& b);
+constexpr const Vector2 operator *(const Vector2& v, float k);
+constexpr const Vector2 operator *(float k, const Vector2& v);
 const Vector2 operator /(const Vector2& v, float k);
 
 Vector2& operator +=(Vector2& a, const Vector2& b);
@@ -50,6 +53,119 @@ Vector2& operator -=(Vector2& a, const Vector2& b);
 Vector2& operator *=(Vector2& v, float k);
 Vector2& operator /=(Vector2& v, float k);
 
+constexpr Vector2::Vector2(float nx, float ny)
+    : x(nx)
+    , y(ny)
+{
+}
+
+inline const float& Vector2::operator [](size_t i) const
+{
+    return const_cast<Vector2&>(*this)[i];
+}
+
+inline float& Vector2::operator [](size_t i)
+{
+    switch (i)
+    {
+    case 0: return x;
+    case 1: return y;
+    }
+    check(false);
+    return x;
+}
+
+inline float Vector2::norm() const
+{
+    return std::sqrt(x * x + y * y);
+}
+
+constexpr float Vector2::dot(const Vector2& v) const
+{
+    return x * v.x + y * v.y;
+}
+
+inline void Vector2::normalize()
+{
+    *this /= norm();
+}
+
+inline void Vector2::scale(const Vector2& k)
+{
+    *this = { x * k.x, y * k.y };
+}
+
+inline bool operator ==(const Vector2& a, const Vector2& b)
+{
+    return equalf(a.x, b.x) && equalf(a.y, b.y);
+}
+
+inline bool operator !=(const Vector2& a, const Vector2& b)
+{
+    return !(a == b);
+}
+
+constexpr const Vector2 operator +(const Vector2& v)
+{
+    return v;
+}
+
+constexpr const Vector2 operator -(const Vector2& v)
+{
+    return{ -v.x, -v.y };
+}
+
+constexpr const Vector2 operator +(const Vector2& a, const Vector2& b)
+{
+    return{ a.x + b.x, a.y + b.y };
+}
+
+constexpr const Vector2 operator -(const Vector2& a, const Vector2& b)
+{
+    return{ a.x - b.x, a.y - b.y };
+}
+
+constexpr const Vector2 operator *(const Vector2& v, float k)
+{
+    return{ v.x * k, v.y * k };
+}
+
+constexpr const Vector2 operator *(float k, const Vector2& v)
+{
+    return v * k;
+}
+
+inline const Vector2 operator /(const Vector2& v, float k)
+{
+    check(!equalf(k, 0));
+    const auto invK = 1 / k;
+    return v * invK;
+}
+
+inline Vector2& operator +=(Vector2& a, const Vector2& b)
+{
+    a = a + b;
+    return a;
+}
+
+inline Vector2& operator -=(Vector2& a, const Vector2& b)
+{
+    a = a - b;
+    return a;
+}
+
+inline Vector2& operator *=(Vector2& v, float k)
+{
+    v = v * k;
+    return v;
+}
+
+inline Vector2& operator /=(Vector2& v, float k)
+{
+    v = v / k;
+    return v;
+}
+
 GF_NAMESPACE_END
 
 #endif
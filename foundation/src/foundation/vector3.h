@@ -1,21 +1,23 @@
 #ifndef GAMEFRIENDS_VECTOR3_H
 #define GAMEFRIENDS_VECTOR3_H
 
+#include "vector2.h"
+#include "vector4.h"
+#include "quaternion.h"
+#include "math.h"
+#include "exception.h"
 #include "prerequest.h"
+#include <cmath>
 
 GF_NAMESPACE_BEGIN
 
-class Vector2;
-class Vector4;
-class Quaternion;
-
 class Vector3
 {
 public:
     float x, y, z;
 
     Vector3() = default;
-    Vector3(float nx, float ny, float nz);
+    constexpr Vector3(float nx, float ny, float nz);
     Vector3(const Vector3&) = default;
 
     Vector3& operator =(const Vector3&) = default;
@@ -24,10 +26,10 @@ public:
     float& operator [](size_t i);
 
     float norm() const;
-    float dot(const Vector3& v) const;
-    Vector3 cross(const Vector3& v) const;
-    Vector2 xy() const;
-    Vector4 xyzw(float w) const;
+    constexpr float dot(const Vector3& v) const;
+    constexpr Vector3 cross(const Vector3& v) const;
+    constexpr Vector2 xy() const;
+    constexpr Vector4 xyzw(float w) const;
 
     void normalize();
     void scale(const Vector3& k);
@@ -41,13 +43,13 @@ public:
 bool operator ==(const Vector3& a, const Vector3& b);
 bool operator !=(const Vector3& a, const Vector3& b);
 
-const Vector3 operator +(const Vector3& v);
-const Vector3 operator -(const Vector3& v);
+constexpr const Vector3 operator +(const Vector3& v);
+constexpr const Vector3 operator -(const Vector3& v);
 
-const Vector3 operator +(const Vector3& a, const Vector3& b);
-const Vector3 operator -(const Vector3& a, const Vector3& b);
-const Vector3 operator *(const Vector3& v, float k);
-const Vector3 operator *(float k, const Vector3& v);
+constexpr const Vector3 operator +(const Vector3& a, const Vector3& b);
+constexpr const Vector3 operator -(const Vector3& a, const Vector3& b);
+constexpr const Vector3 operator *(const Vector3& v, float k);
+constexpr const Vector3 operator *(float k, const Vector3& v);
 const Vector3 operator *(const Quaternion& q, const Vector3& v);
 const Vector3 operator /(const Vector3& v, float k);
 
@@ -56,6 +58,152 @@ Vector3& operator -=(Vector3& a, const Vector3& b);
 Vector3& operator *=(Vector3& v, float k);
 Vector3& operator /=(Vector3& v, float k);
 
+constexpr Vector3::Vector3(float nx, float ny, float nz)
+    : x(nx)
+    , y(ny)
+    , z(nz)
+{
+}
+
+inline const float& Vector3::operator [](size_t i) const
+{
+    return const_cast<Vector3&>(*this)[i];
+}
+
+inline float& Vector3::operator [](size_t i)
+{
+    switch (i)
+    {
+    case 0: return x;
+    case 1: return y;
+    case 2: return z;
+    default:
+        check(false);
+        return x;
+    }
+}
+
+inline float Vector3::norm() const
+{
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+constexpr float Vector3::dot(const Vector3& v) const
+{
+    return x * v.x + y * v.y + z * v.z;
+}
+
+constexpr Vector3 Vector3::cross(const Vector3& v) const
+{
+    return{
+        y * v.z - z * v.y,
+        z * v.x - x * v.z,
+        x * v.y - y * v.x
+    };
+}
+
+constexpr Vector2 Vector3::xy() const
+{
+    return{ x, y };
+}
+
+constexpr Vector4 Vector3::xyzw(float w) const
+{
+    return{ x, y, z, w };
+}
+
+inline void Vector3::normalize()
+{
+    *this /= norm();
+}
+
+inline void Vector3::scale(const Vector3& k)
+{
+    *this = { x * k.x, y * k.y, z * k.z };
+}
+
+inline bool operator ==(const Vector3& a, const Vector3& b)
+{
+    return equalf(a.x, b.x) && equalf(a.y, b.y) && equalf(a.z, b.z);
+}
+
+inline bool operator !=(const Vector3& a, const Vector3& b)
+{
+    return !(a == b);
+}
+
+constexpr const Vector3 operator +(const Vector3& v)
+{
+    return v;
+}
+
+constexpr const Vector3 operator -(const Vector3& v)
+{
+    return{ -v.x, -v.y, -v.z };
+}
+
+constexpr const Vector3 operator +(const Vector3& a, const Vector3& b)
+{
+    return{ a.x + b.x, a.y + b.y, a.z + b.z };
+}
+
+constexpr const Vector3 operator -(const Vector3& a, const Vector3& b)
+{
+    return{ a.x - b.x, a.y - b.y, a.z - b.z };
+}
+
+constexpr const Vector3 operator *(const Vector3& v, float k)
+{
+    return{ v.x * k, v.y * k, v.z * k };
+}
+
+constexpr const Vector3 operator *(float k, const Vector3& v)
+{
+    return v * k;
+}
+
+inline const Vector3 operator *(const Quaternion& q_, const Vector3& v)
+{
+    // Ogre3D (NVIDIA SDK) implementation
+    auto q = q_;
+    q.normalize();
+    const Vector3 qv = { q.x, q.y, q.z };
+    const auto uv = qv.cross(v);
+    const auto uuv = qv.cross(uv);
+    return v + uv * (q.w * 2) + uuv * 2;
+}
+
+inline const Vector3 operator /(const Vector3& v, float k)
+{
+    check(!equalf(k, 0));
+    const auto invK = 1 / k;
+    return v * invK;
+}
+
+inline Vector3& operator +=(Vector3& a, const Vector3& b)
+{
+    a = a + b;
+    return a;
+}
+
+inline Vector3& operator -=(Vector3& a, const Vector3& b)
+{
+    a = a - b;
+    return a;
+}
+
+inline Vector3& operator *=(Vector3& v, float k)
+{
+    v = v * k;
+    return v;
+}
+
+inline Vector3& operator /=(Vector3& v, float k)
+{
+    v = v / k;
+    return v;
+}
+
 GF_NAMESPACE_END
 
 #endif
\ No newline at end of file
@@ -1,7 +1,10 @@
 #ifndef GAMEFRIENDS_VECTOR4_H
 #define GAMEFRIENDS_VECTOR4_H
 
+#include "math.h"
+#include "exception.h"
 #include "prerequest.h"
+#include <cmath>
 
 GF_NAMESPACE_BEGIN
 
@@ -14,7 +17,7 @@ public:
     float x, y, z, w;
 
     Vector4() = default;
-    Vector4(float nx, float ny, float nz, float nw);
+    constexpr Vector4(float nx, float ny, float nz, float nw);
     Vector4(const Vector4&) = default;
 
     Vector4& operator =(const Vector4&) = default;
@@ -23,7 +26,7 @@ public:
     float& operator [](size_t i);
 
     float norm() const;
-    float dot(const Vector4& v) const;
+    constexpr float dot(const Vector4& v) const;
     Vector3 xyz() const;
 
     void normalize();
@@ -39,14 +42,14 @@ public:
 bool operator ==(const Vector4& a, const Vector4& b);
 bool operator !=(const Vector4& a, const Vector4& b);
 
-const Vector4 operator +(const Vector4& v);
-const Vector4 operator -(const Vector4& v);
+constexpr const Vector4 operator +(const Vector4& v);
+constexpr const Vector4 operator -(const Vector4& v);
 
-const Vector4 operator +(const Vector4& a, const Vector4& b);
-const Vector4 operator -(const Vector4& a, const Vector4& b);
+constexpr const Vector4 operator +(const Vector4& a, const Vector4& b);
+constexpr const Vector4 operator -(const Vector4& a, const Vector4& b);
 const Vector4 operator *(const Vector4& v, const Matrix44& m);
-const Vector4 operator *(const Vector4& v, float k);
-const Vector4 operator *(float k, const Vector4& v);
+constexpr const Vector4 operator *(const Vector4& v, float k);
+constexpr const Vector4 operator *(float k, const Vector4& v);
 const Vector4 operator /(const Vector4& v, float k);
 
 Vector4& operator +=(Vector4& a, const Vector4& b);
@@ -55,6 +58,124 @@ Vector4& operator *=(Vector4& v, const Matrix44& m);
 Vector4& operator *=(Vector4& v, float k);
 Vector4& operator /=(Vector4& v, float k);
 
+constexpr Vector4::Vector4(float nx, float ny, float nz, float nw)
+    : x(nx)
+    , y(ny)
+    , z(nz)
+    , w(nw)
+{
+}
+
+inline const float& Vector4::operator [](size_t i) const
+{
+    return const_cast<Vector4&>(*this)[i];
+}
+
+inline float& Vector4::operator [](size_t i)
+{
+    switch (i)
+    {
+    case 0: return x;
+    case 1: return y;
+    case 2: return z;
+    case 3: return w;
+    default:
+        check(false);
+        return x;
+    }
+}
+
+inline float Vector4::norm() const
+{
+    return std::sqrt(x * x + y * y + z * z + w * w);
+}
+
+constexpr float Vector4::dot(const Vector4& v) const
+{
+    return x * v.x + y * v.y + z * v.z + w * v.w;
+}
+
+inline void Vector4::normalize()
+{
+    *this /= norm();
+}
+
+inline void Vector4::scale(const Vector4& k)
+{
+    *this = { x * k.x, y * k.y, z * k.z, w * k.w };
+}
+
+inline bool operator ==(const Vector4& a, const Vector4& b)
+{
+    return equalf(a.x, b.x) && equalf(a.y, b.y) && equalf(a.z, b.z) && equalf(a.w, b.w);
+}
+
+inline bool operator !=(const Vector4& a, const Vector4& b)
+{
+    return !(a == b);
+}
+
+constexpr const Vector4 operator +(const Vector4& v)
+{
+    return v;
+}
+
+constexpr const Vector4 operator -(const Vector4& v)
+{
+    return{ -v.x, -v.y, -v.z, -v.w };
+}
+
+constexpr const Vector4 operator +(const Vector4& a, const Vector4& b)
+{
+    return{ a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w };
+}
+
+constexpr const Vector4 operator -(const Vector4& a, const Vector4& b)
+{
+    return{ a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w };
+}
+
+constexpr const Vector4 operator *(const Vector4& v, float k)
+{
+    return{ v.x * k, v.y * k, v.z * k, v.w * k };
+}
+
+constexpr const Vector4 operator *(float k, const Vector4& v)
+{
+    return v * k;
+}
+
+inline const Vector4 operator /(const Vector4& v, float k)
+{
+    check(!equalf(k, 0));
+    const auto invK = 1 / k;
+    return v * invK;
+}
+
+inline Vector4& operator +=(Vector4& a, const Vector4& b)
+{
+    a = a + b;
+    return a;
+}
+
+inline Vector4& operator -=(Vector4& a, const Vector4& b)
+{
+    a = a - b;
+    return a;
+}
+
+inline Vector4& operator *=(Vector4& v, float k)
+{
+    v = v * k;
+    return v;
+}
+
+inline Vector4& operator /=(Vector4& v, float k)
+{
+    v = v / k;
+    return v;
+}
+
 GF_NAMESPACE_END
 
 #endif
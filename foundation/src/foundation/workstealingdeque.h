@@ -0,0 +1,113 @@
+#ifndef GAMEFRIENDS_WORKSTEALINGDEQUE_H
+#define GAMEFRIENDS_WORKSTEALINGDEQUE_H
+
+#include "prerequest.h"
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+GF_NAMESPACE_BEGIN
+
+/// Chase-Lev work stealing deque with fixed capacity.
+/// The owner thread pushes and pops at the bottom (LIFO); any thread steals from the top (FIFO).
+/// Memory orders follow Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models".
+template <class T, size_t Capacity = 4096>
+class WorkStealingDeque
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity needs be a 2-power");
+    static_assert(std::is_trivially_copyable<T>::value, "Elements are read racily and must be trivially copyable");
+
+private:
+    static const int64 MASK = static_cast<int64>(Capacity) - 1;
+
+    // Owner and thieves write different ends, keep them on separate cache lines
+    std::atomic<int64> top_;
+    char padTop_[64 - sizeof(std::atomic<int64>)];
+    std::atomic<int64> bottom_;
+    char padBottom_[64 - sizeof(std::atomic<int64>)];
+    std::atomic<T> buffer_[Capacity];
+
+public:
+    WorkStealingDeque()
+        : top_(0)
+        , bottom_(0)
+    {
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator =(const WorkStealingDeque&) = delete;
+
+    /// Owner only. Returns false when full.
+    bool push(T val)
+    {
+        const auto b = bottom_.load(std::memory_order_relaxed);
+        const auto t = top_.load(std::memory_order_acquire);
+        if (b - t > MASK)
+        {
+            return false;
+        }
+
+        buffer_[b & MASK].store(val, std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Owner only
+    bool pop(T& out)
+    {
+        const auto b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top_.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // Empty
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = buffer_[b & MASK].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            // Last element, race against thieves
+            const auto won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /// Any thread. Fails when empty or when another thread won the race.
+    bool steal(T& out)
+    {
+        auto t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b)
+        {
+            return false;
+        }
+
+        out = buffer_[t & MASK].load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /// Approximate when other threads are active
+    size_t size() const
+    {
+        const auto b = bottom_.load(std::memory_order_relaxed);
+        const auto t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+};
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -9,7 +9,7 @@ GF_NAMESPACE_BEGIN
 
 bool operator ==(const EnginePath& a, const EnginePath& b)
 {
-    return a.s == b.s;
+    return a.id == b.id && a.s == b.s;
 }
 
 bool operator !=(const EnginePath& a, const EnginePath& b)
@@ -45,6 +45,8 @@ void FileSystem::startup(const std::string& engineRoot)
         throw FileSystemError("The required root directory (" + engineRoot + ") is not exists.");
     }
 
+    osPathCache_.clear();
+
     char cur[512];
     GetCurrentDirectoryA(512, cur);
     osCurDir_ = Uri::uniform(cur);
@@ -63,6 +65,7 @@ void FileSystem::startup(const std::string& engineRoot)
 
 void FileSystem::shutdown()
 {
+    osPathCache_.clear();
     GF_LOG_INFO("FileSystem shutdown.");
 }
 
@@ -73,7 +76,27 @@ EnginePath FileSystem::uniform(const EnginePath& path) const
 
 std::string FileSystem::toOSPath(const EnginePath& path) const
 {
-    return Uri::relativePath(osCurDir_, engineRoot_ + '/' + path.s);
+    std::lock_guard<std::mutex> lock(osPathMutex_);
+
+    const auto found = osPathCache_.find(path);
+    if (found != std::end(osPathCache_))
+    {
+        return found->second;
+    }
+
+    auto osPath = Uri::relativePath(osCurDir_, engineRoot_ + '/' + path.s);
+    osPathCache_.emplace(path, osPath);
+    return osPath;
+}
+
+uint64 FileSystem::lastWriteTime(const std::string& osPath) const
+{
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(osPath.c_str(), GetFileExInfoStandard, &attributes))
+    {
+        return 0;
+    }
+    return (static_cast<uint64>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
 }
 
 FileSystem fileSystem;
@@ -2,8 +2,11 @@
 #define GAMEFRIENDS_FILESYSTEM_H
 
 #include "foundation/exception.h"
+#include "foundation/stringid.h"
+#include "foundation/hashmap.h"
 #include "foundation/prerequest.h"
 #include <string>
+#include <mutex>
 
 GF_NAMESPACE_BEGIN
 
@@ -17,9 +20,10 @@ public:
 struct EnginePath
 {
     std::string s;
+    StringId id; /// Hash of s for cheap hashing and inequality
 
     EnginePath() = default;
-    explicit EnginePath(const std::string& p) : s(p) {};
+    explicit EnginePath(const std::string& p) : s(p), id(p) {};
 };
 
 bool operator ==(const EnginePath& a, const EnginePath& b);
@@ -29,34 +33,45 @@ bool operator <=(const EnginePath& a, const EnginePath& b);
 bool operator >(const EnginePath& a, const EnginePath& b);
 bool operator >=(const EnginePath& a, const EnginePath& b);
 
+GF_NAMESPACE_END
+
+namespace std
+{
+    template <>
+    struct hash<GF_NAMESPACE::EnginePath>
+    {
+        size_t operator ()(const GF_NAMESPACE::EnginePath& p) const
+        {
+            return std::hash<GF_NAMESPACE::StringId>()(p.id);
+        }
+    };
+}
+
+GF_NAMESPACE_BEGIN
+
 class FileSystem
 {
 private:
     std::string osCurDir_;
     std::string engineRoot_;
 
+    /// Resolved OS paths. Resources are constructed for the same paths repeatedly.
+    mutable std::mutex osPathMutex_;
+    mutable HashMap<EnginePath, std::string> osPathCache_;
+
 public:
     void startup(const std::string& engineRoot) noexcept(false);
     void shutdown();
 
     EnginePath uniform(const EnginePath& path) const;
     std::string toOSPath(const EnginePath& path) const;
+
+    /// Last modification of an OS path in 100ns ticks. 0 if the file does not exist.
+    uint64 lastWriteTime(const std::string& osPath) const;
 };
 
 extern FileSystem fileSystem;
 
 GF_NAMESPACE_END
 
-namespace std
-{
-    template <>
-    struct hash<GF_NAMESPACE::EnginePath>
-    {
-        size_t operator ()(const GF_NAMESPACE::EnginePath& p) const
-        {
-            return std::hash<std::string>()(p.s);
-        }
-    };
-}
-
 #endif
@@ -7,8 +7,8 @@
 #include "logging.h"
 #include "foundation/metaprop.h"
 #include "foundation/exception.h"
+#include "foundation/hashmap.h"
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 GF_NAMESPACE_BEGIN
@@ -42,7 +42,7 @@ bool ShadeModel::loadImpl()
 
     try
     {
-        std::unordered_map<std::string, MatParamType> paramTypes;
+        HashMap<std::string, MatParamType> paramTypes;
 
         // @Parameters
         enforce<ShadeModelLoadException>(file.has("Parameters"), ".shade requires @Parameters.");
@@ -99,22 +99,22 @@ bool ShadeModel::loadImpl()
                     const auto param = Map[0];
                     const auto mapTo = Map[1];
 
-                    enforce<ShadeModelLoadException>(paramTypes.find(param) != std::cend(paramTypes),
+                    enforce<ShadeModelLoadException>(paramTypes.contains(param),
                         "Parameter " + param + " not found in Map:.");
 
-                    const auto type = paramTypes[param];
+                    const auto type = paramTypes.at(param);
                     detail::Mapping mapping;
                     mapping.maxSize = sizeofMatParam(type);
-                    mapping.toName = mapTo;
+                    mapping.toName = StringId::intern(mapTo);
                     mapping.toType = stageType;
 
                     if (isNumeric(type))
                     {
-                        numericMappings_.emplace(param, mapping);
+                        numericMappings_[StringId::intern(param)].push_back(mapping);
                     }
                     else
                     {
-                        textureMappings_.emplace(param, mapping);
+                        textureMappings_[StringId::intern(param)].push_back(mapping);
                     }
                 }
             }
@@ -223,7 +223,7 @@ bool Material::loadImpl()
             {
                 holder.numeric.reset(new char[sizeofMatParam(type)]);
             }
-            params_.emplace(name, holder);
+            params_.emplace(StringId::intern(name), holder);
         }
 
         shadeModelIn_ = model->createInput();
@@ -233,7 +233,8 @@ bool Material::loadImpl()
             MatParamType type;
             model->parameter(i, name, type);
 
-            auto& holder = params_[name];
+            const auto id = StringId(name);
+            auto& holder = params_.at(id);
 
             enforce<MaterialLoadException>(Shade.has(name),
                 ".material requires parameter value " + name + " in @Shade.");
@@ -243,14 +244,10 @@ bool Material::loadImpl()
             {
                 if (isFloating(type))
                 {
-                    const auto propSize = prop.size();
                     const auto floats = reinterpret_cast<float*>(holder.numeric.get());
-                    for (size_t n = 0; n < sizeofMatParam(type) / sizeof(float) && n < propSize; ++n)
-                    {
-                        floats[n] = prop.stof(n);
-                    }
+                    prop.parse(floats, sizeofMatParam(type) / sizeof(float));
                 }
-                shadeModelIn_->updateNumeric(name, holder.numeric.get(), sizeofMatParam(type));
+                shadeModelIn_->updateNumeric(id, holder.numeric.get(), sizeofMatParam(type));
             }
             else
             {
@@ -261,7 +258,7 @@ bool Material::loadImpl()
                 tex->load();
                 enforce<TextureLoadException>(tex->ready(), "Failed to load texture.");
                 holder.texture = tex;
-                shadeModelIn_->updateTexture(name, tex->resource());
+                shadeModelIn_->updateTexture(id, tex->resource());
             }
         }
     }
@@ -271,6 +268,12 @@ bool Material::loadImpl()
         unloadImpl();
         return false;
     }
+    catch (const InvalidMetaPropFile& e)
+    {
+        GF_LOG_WARN("Failed to load material {}. {}", osPath(), e.msg());
+        unloadImpl();
+        return false;
+    }
 
     return true;
 }
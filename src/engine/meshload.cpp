@@ -6,132 +6,176 @@
 #include "resource.h"
 #include "logging.h"
 #include "foundation/metaprop.h"
+#include "foundation/metapropbinary.h"
 #include "foundation/exception.h"
 
 GF_NAMESPACE_BEGIN
 
 namespace
 {
-    template <class T>
-    bool getFloatBuffer(const MetaPropGroup& Vertex, const std::string& propName, std::vector<T>& buffer)
+    /// Text values are parsed into scratch
+    const float* toFloats(const MetaProperty& prop, std::vector<float>& scratch)
     {
-        if (Vertex.has(propName))
-        {
-            buffer.clear();
-            const auto& V = Vertex.get(propName);
-            const auto size = V.size();
-            buffer.resize(size);
-            for (size_t i = 0; i < size; ++i)
-            {
-                buffer[i] = V.stof(i);
-            }
-            return true;
-        }
-        return false;
+        scratch.resize(prop.size());
+        prop.parse(scratch.data(), scratch.size());
+        return scratch.data();
     }
 
-    template <class T>
-    bool getIntBuffer(const MetaPropGroup& Vertex, const std::string& propName, std::vector<T>& buffer)
+    /// float32 values are used in place, others are converted into scratch
+    const float* toFloats(const BinaryMetaProperty& prop, std::vector<float>& scratch)
     {
-        if (Vertex.has(propName))
+        if (prop.type() == MetaPropType::_float32)
         {
-            buffer.clear();
-            const auto& V = Vertex.get(propName);
-            const auto size = V.size();
-            buffer.resize(size);
-            for (size_t i = 0; i < size; ++i)
-            {
-                buffer[i] = V.stoi(i);
-            }
-            return true;
+            return prop.floats();
         }
-        return false;
+        scratch.resize(prop.size());
+        prop.copyTo(scratch.data());
+        return scratch.data();
     }
-}
-
-bool Mesh::loadImpl()
-{
-    MetaPropFile file;
 
-    try
+    const uint16* toIndices(const MetaProperty& prop, std::vector<uint16>& scratch)
     {
-        file.read(osPath());
+        scratch.resize(prop.size());
+        prop.parse(scratch.data(), scratch.size());
+        return scratch.data();
     }
-    catch (const Exception& e)
+
+    const uint16* toIndices(const BinaryMetaProperty& prop, std::vector<uint16>& scratch)
     {
-        GF_LOG_WARN("Failed to load mesh {}. {}", osPath(), e.msg());
-        return false;
+        if (prop.type() == MetaPropType::_uint16)
+        {
+            return prop.uint16s();
+        }
+        scratch.resize(prop.size());
+        prop.copyTo(scratch.data());
+        return scratch.data();
     }
 
-    vertexData_ = std::make_shared<VertexData>();
-
-    try
+    /// Sets a vertex stream or the indices from a property of @Vertex. Returns false for other properties.
+    template <class Property>
+    bool setVertexArray(VertexData& vertexData, AxisAlignedBox& bounds, StringRef name, const Property& prop,
+        std::vector<float>& floats, std::vector<uint16>& ints)
     {
-        std::vector<float> floats;
-        std::vector<unsigned short> ints;
-
-        // @Vertex
-        enforce<MeshLoadException>(file.has("Vertex"), ".mesh requires @Vertex.");
-        const auto& Vertex = file.get("Vertex");
-
-        enforce<MeshLoadException>(Vertex.has("Topology") && Vertex.get("Topology").size() >= 1,
-            ".mesh requires Topology: <topology> in @Vertex.");
-        vertexData_->setTopology(static_cast<PrimitiveTopology>(Vertex.get("Topology").stoi(0)));
+        if (name == "V")
+        {
+            const auto data = toFloats(prop, floats);
+            vertexData.setVertices(Semantics::POSITION, 0, data, prop.size() * sizeof(float), PixelFormat::RGB32_float);
 
-        if (getFloatBuffer(Vertex, "V", floats))
+            bounds = AxisAlignedBox::NEGATIVE;
+            for (size_t i = 0; i + 2 < prop.size(); i += 3)
+            {
+                bounds.merge(Vector3(data[i], data[i + 1], data[i + 2]));
+            }
+        }
+        else if (name == "N")
         {
-            vertexData_->setVertices(Semantics::POSITION, 0, floats.data(), floats.size() * sizeof(float), PixelFormat::RGB32_float);
+            vertexData.setVertices(Semantics::NORMAL, 0, toFloats(prop, floats), prop.size() * sizeof(float), PixelFormat::RGB32_float);
         }
-        if (getFloatBuffer(Vertex, "N", floats))
+        else if (name == "C")
         {
-            vertexData_->setVertices(Semantics::NORMAL, 0, floats.data(), floats.size() * sizeof(float), PixelFormat::RGB32_float);
+            vertexData.setVertices(Semantics::COLOR, 0, toFloats(prop, floats), prop.size() * sizeof(float), PixelFormat::RGBA32_float);
         }
-        if (getFloatBuffer(Vertex, "C", floats))
+        else if (name == "U")
         {
-            vertexData_->setVertices(Semantics::COLOR, 0, floats.data(), floats.size() * sizeof(float), PixelFormat::RGBA32_float);
+            vertexData.setVertices(Semantics::TEXCOORD, 0, toFloats(prop, floats), prop.size() * sizeof(float), PixelFormat::RG32_float);
         }
-        if (getFloatBuffer(Vertex, "U", floats))
+        else if (name == "I")
         {
-            vertexData_->setVertices(Semantics::TEXCOORD, 0, floats.data(), floats.size() * sizeof(float), PixelFormat::RG32_float);
+            vertexData.setIndices(toIndices(prop, ints), prop.size() * sizeof(uint16));
         }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /// Sets the arrays of @Vertex as soon as each is parsed and keeps the rest of the file for Mesh::loadFrom.
+    /// Only one array is held in memory at a time.
+    class MeshStreamHandler : public MetaPropHandler
+    {
+    private:
+        VertexData& vertexData_;
+        AxisAlignedBox& bounds_;
+        MetaPropFile& rest_;
+        MetaPropGroup group_;
+        bool inVertex_;
+        std::vector<float> floats_;
+        std::vector<uint16> ints_;
 
-        if (getIntBuffer(Vertex, "I", ints))
+    public:
+        MeshStreamHandler(VertexData& vertexData, AxisAlignedBox& bounds, MetaPropFile& rest)
+            : vertexData_(vertexData)
+            , bounds_(bounds)
+            , rest_(rest)
+            , group_()
+            , inVertex_(false)
+            , floats_()
+            , ints_()
         {
-            vertexData_->setIndices(ints.data(), ints.size() * sizeof(unsigned short));
         }
 
-        for (int i = 0; file.has("SubMesh" + std::to_string(i)); ++i)
+        void beginGroup(StringRef name) override
         {
-            const auto& SubMeshGroup = file.get("SubMesh" + std::to_string(i));
+            group_ = MetaPropGroup(name.str());
+            inVertex_ = name == "Vertex";
+        }
 
-            enforce<MeshLoadException>(SubMeshGroup.has("Name") && SubMeshGroup.get("Name").size() >= 1,
-                ".mesh requires Name: <name> in @SubMesh.");
-            const auto name = SubMeshGroup.get("Name")[0];
+        void endGroup(StringRef) override
+        {
+            rest_.add(std::move(group_));
+        }
 
-            enforce<MeshLoadException>(SubMeshGroup.has("Material") && SubMeshGroup.get("Material").size() >= 1,
-                ".mesh requires Material: <path> in @SubMesh.");
-            const auto materialPath = SubMeshGroup.get("Material")[0];
+        void property(const MetaProperty& prop) override
+        {
+            if (!inVertex_ || !setVertexArray(vertexData_, bounds_, prop.name(), prop, floats_, ints_))
+            {
+                group_.add(prop);
+            }
+        }
+    };
+}
 
-            enforce<MeshLoadException>(SubMeshGroup.has("Indexed") && SubMeshGroup.get("Indexed").size() >= 1,
-                ".mesh requires Indexed: <bool> in @SubMesh.");
-            const auto indexed = !!SubMeshGroup.get("Indexed").stoi(0);
+bool Mesh::loadImpl()
+{
+    // A binary file written after the text source takes its place
+    const auto binaryPath = osPath() + ".bin";
+    const auto useBinary = fileSystem.lastWriteTime(binaryPath) > fileSystem.lastWriteTime(osPath());
 
-            enforce<MeshLoadException>(SubMeshGroup.has("Range") && SubMeshGroup.get("Range").size() >= 2,
-                ".mesh requires Range: <begin> <count> in @SubMesh.");
-            const auto& Range = SubMeshGroup.get("Range");
+    vertexData_ = std::make_shared<VertexData>();
 
-            const auto material = resourceManager.template obtain<Material>(EnginePath(materialPath));
-            material->load();
-            enforce<MaterialLoadException>(material->ready(), "Failed to load material.");
+    MetaPropFile textFile;
+    BinaryMetaPropFile binaryFile;
 
-            SubMesh subMesh;
-            subMesh.name = name;
-            subMesh.material = material;
-            subMesh.indexed = indexed;
-            subMesh.offset = Range.stoi(0);
-            subMesh.count = Range.stoi(1);
+    try
+    {
+        if (useBinary)
+        {
+            binaryFile.open(binaryPath);
+        }
+        else
+        {
+            // Vertex arrays are set while streaming, textFile keeps the rest
+            MeshStreamHandler handler(*vertexData_, bounds_, textFile);
+            MetaPropFile::stream(osPath(), handler);
+        }
+    }
+    catch (const Exception& e)
+    {
+        GF_LOG_WARN("Failed to load mesh {}. {}", useBinary ? binaryPath : osPath(), e.msg());
+        unloadImpl();
+        return false;
+    }
 
-            addSubMesh(subMesh);
+    try
+    {
+        if (useBinary)
+        {
+            loadFrom(binaryFile);
+        }
+        else
+        {
+            loadFrom(textFile);
         }
     }
     catch (const ResourceException& e)
@@ -140,6 +184,12 @@ bool Mesh::loadImpl()
         unloadImpl();
         return false;
     }
+    catch (const InvalidMetaPropFile& e)
+    {
+        GF_LOG_WARN("Failed to load mesh {}. {}", osPath(), e.msg());
+        unloadImpl();
+        return false;
+    }
     
     auto& copy = sceneAppContext.copyCommandBuilder();
     auto& graphics = sceneAppContext.graphicsCommandBuilder();
@@ -149,10 +199,68 @@ bool Mesh::loadImpl()
     return true;
 }
 
+template <class File>
+void Mesh::loadFrom(const File& file)
+{
+    std::vector<float> floats;
+    std::vector<uint16> ints;
+
+    // @Vertex
+    enforce<MeshLoadException>(file.has("Vertex"), ".mesh requires @Vertex.");
+    const auto& Vertex = file.get("Vertex");
+
+    enforce<MeshLoadException>(Vertex.has("Topology") && Vertex.get("Topology").size() >= 1,
+        ".mesh requires Topology: <topology> in @Vertex.");
+    vertexData_->setTopology(static_cast<PrimitiveTopology>(Vertex.get("Topology").stoi(0)));
+
+    for (const auto name : { "V", "N", "C", "U", "I" })
+    {
+        if (Vertex.has(name))
+        {
+            setVertexArray(*vertexData_, bounds_, name, Vertex.get(name), floats, ints);
+        }
+    }
+
+    for (int i = 0; file.has("SubMesh" + std::to_string(i)); ++i)
+    {
+        const auto& SubMeshGroup = file.get("SubMesh" + std::to_string(i));
+
+        enforce<MeshLoadException>(SubMeshGroup.has("Name") && SubMeshGroup.get("Name").size() >= 1,
+            ".mesh requires Name: <name> in @SubMesh.");
+        const std::string name = SubMeshGroup.get("Name")[0];
+
+        enforce<MeshLoadException>(SubMeshGroup.has("Material") && SubMeshGroup.get("Material").size() >= 1,
+            ".mesh requires Material: <path> in @SubMesh.");
+        const std::string materialPath = SubMeshGroup.get("Material")[0];
+
+        enforce<MeshLoadException>(SubMeshGroup.has("Indexed") && SubMeshGroup.get("Indexed").size() >= 1,
+            ".mesh requires Indexed: <bool> in @SubMesh.");
+        const auto indexed = !!SubMeshGroup.get("Indexed").stoi(0);
+
+        enforce<MeshLoadException>(SubMeshGroup.has("Range") && SubMeshGroup.get("Range").size() >= 2,
+            ".mesh requires Range: <begin> <count> in @SubMesh.");
+        const auto& Range = SubMeshGroup.get("Range");
+
+        const auto material = resourceManager.template obtain<Material>(EnginePath(materialPath));
+        material->load();
+        enforce<MaterialLoadException>(material->ready(), "Failed to load material.");
+
+        SubMesh subMesh;
+        subMesh.name = name;
+        subMesh.material = material;
+        subMesh.indexed = indexed;
+        subMesh.offset = Range.stoi(0);
+        subMesh.count = Range.stoi(1);
+
+        addSubMesh(subMesh);
+    }
+}
+
 void Mesh::unloadImpl()
 {
     subMeshes_.clear();
     vertexData_.reset();
+    bounds_ = AxisAlignedBox::NEGATIVE;
 }
 
 GF_NAMESPACE_END
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "foundation/string.h"
 #include "foundation/matrix44.h"
 #include "foundation/math.h"
+#include "foundation/jobsystem.h"
 
 GF_NAMESPACE_BEGIN
 
@@ -97,6 +98,10 @@ void Application::go()
         latestDeltaTimes_s_.push_back(frameTime_us_ * 0.000001f);
     }
 
+    // Jobs
+    jobSystem.startup();
+    GF_LOG_INFO("JobSystem initialized with {} threads.", jobSystem.numThreads());
+
     // Resource
     fileSystem.startup("asset");
     resourceManager.startup();
@@ -201,6 +206,9 @@ void Application::go()
     resourceManager.shutdown();
     fileSystem.shutdown();
 
+    // Jobs
+    jobSystem.shutdown();
+
     window.reset();
 
     logManager.shutdown();
@@ -1,7 +1,9 @@
 #include "physicsworld.h"
 #include "foundation/color.h"
 #include "rigidbody.h"
-#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <utility>
 
 #include "collisionshape.h"
 #include <algorithm>
@@ -17,9 +19,23 @@ void PhysicsDebugDraw::drawLine(const btVector3& from, const btVector3& to_, con
 
 namespace
 {
+    using BodyPair = std::pair<RigidBody*, RigidBody*>;
+
+    struct BodyPairHash
+    {
+        size_t operator ()(const BodyPair& pair) const
+        {
+            const std::hash<RigidBody*> hash;
+            return hash(pair.first) ^ (hash(pair.second) * 31);
+        }
+    };
+
+    /// Collided pairs ordered by address, each once
+    using CollidedPairs = std::unordered_set<BodyPair, BodyPairHash, std::equal_to<BodyPair>, ArenaStdAllocator<BodyPair>>;
+
     void tickCallback(btDynamicsWorld* world, btScalar)
     {
-        const auto cllidedObjects = static_cast<std::unordered_map<RigidBody*, std::unordered_set<RigidBody*>>*>(world->getWorldUserInfo());
+        const auto cllidedObjects = static_cast<CollidedPairs*>(world->getWorldUserInfo());
         const auto numManifolds = world->getDispatcher()->getNumManifolds();
         for (int i = 0; i < numManifolds; i++)
         {
@@ -28,11 +44,11 @@ namespace
             auto bodyB = static_cast<RigidBody*>(manifold->getBody1()->getUserPointer());
             if (bodyA < bodyB)
             {
-                cllidedObjects->operator[](bodyA).emplace(bodyB);
+                cllidedObjects->emplace(bodyA, bodyB);
             }
             else
             {
-                cllidedObjects->operator[](bodyB).emplace(bodyA);
+                cllidedObjects->emplace(bodyB, bodyA);
             }
         }
     }
@@ -45,6 +61,7 @@ PhysicsWorld::PhysicsWorld()
     , solver_()
     , world_()
     , debugDrawer_(nullptr)
+    , stepArena_()
 {
     config_.reset(new btDefaultCollisionConfiguration());
     dispather_.reset(new btCollisionDispatcher(config_.get()));
@@ -94,18 +111,19 @@ void PhysicsWorld::removeRigidBody(RigidBody& body)
 void PhysicsWorld::stepSimulation(float dt_s)
 {
     static const auto FIXED_TIME_STEP = 0.01666666754f;
-    std::unordered_map<RigidBody*, std::unordered_set<RigidBody*>> collidedObjects;
-
-    world_->setWorldUserInfo(&collidedObjects);
-    world_->stepSimulation(dt_s, static_cast<int>(dt_s / FIXED_TIME_STEP + 1.0001f), FIXED_TIME_STEP);
-    world_->setWorldUserInfo(nullptr);
+    stepArena_.reset();
 
-    for (const auto& bodyA : collidedObjects)
     {
-        for (const auto& bodyB : bodyA.second)
+        CollidedPairs collidedObjects(0, BodyPairHash(), std::equal_to<BodyPair>(), ArenaStdAllocator<BodyPair>(stepArena_));
+
+        world_->setWorldUserInfo(&collidedObjects);
+        world_->stepSimulation(dt_s, static_cast<int>(dt_s / FIXED_TIME_STEP + 1.0001f), FIXED_TIME_STEP);
+        world_->setWorldUserInfo(nullptr);
+
+        for (const auto& pair : collidedObjects)
         {
-            bodyA.first->notifyCollision(*bodyB);
-            bodyB->notifyCollision(*bodyA.first);
+            pair.first->notifyCollision(*pair.second);
+            pair.second->notifyCollision(*pair.first);
         }
     }
 
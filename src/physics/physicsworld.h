@@ -2,10 +2,10 @@
 #define GAMEFRIENDS_PHYSICSWORLD_H
 
 #include "bulletinc.h"
+#include "foundation/arenaallocator.h"
 #include "foundation/prerequest.h"
 #include <LinearMath/btIDebugDraw.h>
 #include <memory>
-#include <unordered_set>
 
 GF_NAMESPACE_BEGIN
 
@@ -36,6 +36,9 @@ private:
 
     btIDebugDraw* debugDrawer_;
 
+    /// Scratch memory of stepSimulation, rewound every step
+    ArenaAllocator stepArena_;
+
 public:
     PhysicsWorld();
     ~PhysicsWorld();
@@ -3,25 +3,35 @@
 #include "renderstate.h"
 #include "pipeline.h"
 #include "d3dsupport.h"
+#include <cstring>
+#include <cstddef>
 
 GF_NAMESPACE_BEGIN
 
 OptimizedDrawCall::OptimizedDrawCall()
     : psoDesc_{}
+    , psoKeyDirty_(true)
+    , shaderStateHash_(0)
+    , rootSignatureKey_(makeRootSignatureKey({}))
     , renderTarget_(CPU_DESCRIPTOR_UNKOWN)
     , depthStencil_(CPU_DESCRIPTOR_UNKOWN)
     , viewport_{}
-    , shaderSignature_{}
     , descriptorHeaps_()
     , rootParameters_()
     , vertices_{}
 {
+    // Keys are compared bytewise, so padding must be zero
+    std::memset(&psoDesc_, 0, sizeof(psoDesc_));
+    std::memset(&psoKey_, 0, sizeof(psoKey_));
+
     psoDesc_.RasterizerState = D3DMappings::RASTERIZER_DESC(RasterizerState::DEFAULT);
     psoDesc_.BlendState = CD3DX12_BLEND_DESC(CD3DX12_DEFAULT());
     psoDesc_.DepthStencilState = D3DMappings::DEPTH_STENCIL_DESC(DepthState::DEFAULT);
     psoDesc_.SampleMask = UINT_MAX;
     psoDesc_.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_UNDEFINED;
     psoDesc_.SampleDesc.Count = 1;
+
+    updateShaderState();
 }
 
 void OptimizedDrawCall::setVertex(const VertexData& vertex, size_t vertexOffset, size_t vertexCount,
@@ -55,17 +65,23 @@ void OptimizedDrawCall::setShaders(const ShaderProgram& shaders)
     psoDesc_.VS = shaders.shaderStage(ShaderType::vertex); 
     psoDesc_.GS = shaders.shaderStage(ShaderType::geometry); 
     psoDesc_.PS = shaders.shaderStage(ShaderType::pixel);
-    shaderSignature_ = shaders.shaderSignatures();
+    psoKey_.vs = hashShaderBytecode(psoDesc_.VS);
+    psoKey_.gs = hashShaderBytecode(psoDesc_.GS);
+    psoKey_.ps = hashShaderBytecode(psoDesc_.PS);
+    rootSignatureKey_ = makeRootSignatureKey(shaders.shaderSignatures());
+    updateShaderState();
 }
 
 void OptimizedDrawCall::setDepthState(const DepthState& ds)
 {
     psoDesc_.DepthStencilState = D3DMappings::DEPTH_STENCIL_DESC(ds);
+    updateShaderState();
 }
 
 void OptimizedDrawCall::setRasterizerState(const RasterizerState& rs)
 {
     psoDesc_.RasterizerState = D3DMappings::RASTERIZER_DESC(rs);
+    updateShaderState();
 }
 
 void OptimizedDrawCall::setRenderTarget(PixelBuffer& rt)
@@ -74,6 +90,7 @@ void OptimizedDrawCall::setRenderTarget(PixelBuffer& rt)
     renderTarget_ = view.descriptor;
     psoDesc_.NumRenderTargets = 1;
     psoDesc_.RTVFormats[0] = view.desc.Format;
+    psoKeyDirty_ = true;
 }
 
 void OptimizedDrawCall::setDepthTarget(PixelBuffer& dt)
@@ -81,6 +98,7 @@ void OptimizedDrawCall::setDepthTarget(PixelBuffer& dt)
     const auto view = dt.depthTargetView();
     depthStencil_ = view.descriptor;
     psoDesc_.DSVFormat = view.desc.Format;
+    psoKeyDirty_ = true;
 }
 
 void OptimizedDrawCall::setViewport(const Viewport& vp)
@@ -90,9 +108,10 @@ void OptimizedDrawCall::setViewport(const Viewport& vp)
 
 void OptimizedDrawCall::trigger(ID3D12GraphicsCommandList& list) const
 {
-    psoDesc_.pRootSignature = &RootSignatureObtain()(shaderSignature_);
+    psoDesc_.pRootSignature = &RootSignatureObtain()(rootSignatureKey_);
 
-    auto& pso = GraphicsPipelineStateObtain()(psoDesc_);
+    updatePsoKey();
+    auto& pso = GraphicsPipelineStateObtain()(psoKey_, psoDesc_);
     list.SetPipelineState(&pso);
     list.SetGraphicsRootSignature(psoDesc_.pRootSignature);
 
@@ -141,6 +160,48 @@ void OptimizedDrawCall::setVertexCommon(const VertexData& vertex, size_t instanc
     vertices_.vertexBuffers = vertex.vertexBuffers();
     psoDesc_.InputLayout = vertex.inputLayout();
     psoDesc_.PrimitiveTopologyType = correspondTopologyType(vertices_.primitiveTopology);
+    psoKey_.inputLayout = vertex.inputLayoutHash();
+    psoKeyDirty_ = true;
+}
+
+void OptimizedDrawCall::updateShaderState()
+{
+    copyPsoState();
+    shaderStateHash_ = hashShaderState(psoKey_);
+    psoKeyDirty_ = true;
+}
+
+void OptimizedDrawCall::updatePsoKey() const
+{
+    if (psoKeyDirty_)
+    {
+        copyPsoState();
+        psoKey_.hash = hashTargetState(psoKey_, shaderStateHash_);
+        psoKeyDirty_ = false;
+    }
+}
+
+void OptimizedDrawCall::copyPsoState() const
+{
+    auto& state = psoKey_.state;
+    std::memcpy(&state, &psoDesc_, sizeof(state));
+    std::memset(&state.pRootSignature, 0, sizeof(state.pRootSignature));
+
+    // Struct copies may carry garbage in the padding after the stencil masks
+    const auto masksEnd = offsetof(D3D12_DEPTH_STENCIL_DESC, StencilWriteMask) + sizeof(UINT8);
+    std::memset(reinterpret_cast<char*>(&state.DepthStencilState) + masksEnd, 0,
+        offsetof(D3D12_DEPTH_STENCIL_DESC, FrontFace) - masksEnd);
+
+    // after the write mask of each render target blend
+    const auto writeMaskEnd = offsetof(D3D12_RENDER_TARGET_BLEND_DESC, RenderTargetWriteMask) + sizeof(UINT8);
+    for (auto& target : state.BlendState.RenderTarget)
+    {
+        std::memset(reinterpret_cast<char*>(&target) + writeMaskEnd, 0, sizeof(target) - writeMaskEnd);
+    }
+
+    // and after the input element count on x64
+    const auto countEnd = offsetof(D3D12_INPUT_LAYOUT_DESC, NumElements) + sizeof(UINT);
+    std::memset(reinterpret_cast<char*>(&state.InputLayout) + countEnd, 0, sizeof(state.InputLayout) - countEnd);
 }
 
 GF_NAMESPACE_END
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define GAMEFRIENDS_DRAWCALL_H
 
 #include "rootsignature.h"
+#include "pipelinekey.h"
 #include "shaderprogram.h"
 #include "vertexdata.h"
 #include "foundation/prerequest.h"
@@ -18,10 +19,13 @@ class OptimizedDrawCall
 {
 private:
     mutable D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc_;
+    mutable PipelineStateKey psoKey_;
+    mutable bool psoKeyDirty_;
+    uint64 shaderStateHash_;
+    RootSignatureKey rootSignatureKey_;
     D3D12_CPU_DESCRIPTOR_HANDLE renderTarget_;
     D3D12_CPU_DESCRIPTOR_HANDLE depthStencil_;
     D3D12_VIEWPORT viewport_;
-    EachShaderSignature shaderSignature_;
     decltype(std::declval<ShaderParameters>().usedDescriptorHeaps()) descriptorHeaps_;
     decltype(std::declval<ShaderParameters>().rootParameters()) rootParameters_;
 
@@ -63,6 +67,12 @@ public:
 
 private:
     void setVertexCommon(const VertexData& vertex, size_t instanceOffset, size_t instanceCount);
+
+    /// The shader part of the key is hashed by the setters that run at load time.
+    /// The rest is mixed in by trigger when a per draw setter marked it dirty.
+    void updateShaderState();
+    void updatePsoKey() const;
+    void copyPsoState() const;
 };
 
 GF_NAMESPACE_END
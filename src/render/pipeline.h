@@ -1,23 +1,24 @@
 #ifndef GAMEFRIENDS_PIPELINESTATE_H
 #define GAMEFRIENDS_PIPELINESTATE_H
 
+#include "pipelinekey.h"
 #include "../windowing/windowsinc.h"
+#include "foundation/hashmap.h"
 #include "foundation/prerequest.h"
 #include <d3d12.h>
-#include <unordered_map>
 
 GF_NAMESPACE_BEGIN
 
 struct GraphicsPipelineStateObtain
 {
-    ID3D12PipelineState& operator ()(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) noexcept(false);
+    ID3D12PipelineState& operator ()(const PipelineStateKey& key, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) noexcept(false);
 };
 
 struct GraphicsPipelineStateCache
 {
 private:
     ID3D12Device* device_;
-    std::unordered_map<unsigned, ComPtr<ID3D12PipelineState>> table_;
+    HashMap<PipelineStateKey, ComPtr<ID3D12PipelineState>, PrecomputedHash> table_;
 
 public:
     void construct(ID3D12Device* device);
@@ -27,7 +28,8 @@ public:
     GraphicsPipelineStateCache(const GraphicsPipelineStateCache&) = delete;
     GraphicsPipelineStateCache& operator=(const GraphicsPipelineStateCache&) = delete;
 
-    ID3D12PipelineState& obtain(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& key) noexcept(false);
+    /// desc is only read to create a missing object
+    ID3D12PipelineState& obtain(const PipelineStateKey& key, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) noexcept(false);
 };
 
 GF_NAMESPACE_END
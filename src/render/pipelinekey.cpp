@@ -0,0 +1,140 @@
+#include "pipelinekey.h"
+#include "foundation/hashmap.h"
+#include "foundation/math.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+GF_NAMESPACE_BEGIN
+
+namespace
+{
+    uint64 mix(uint64 h, uint64 v)
+    {
+        // Same round as hash64 for word sized inputs
+        h ^= v * 0xC2B2AE3D27D4EB4FULL;
+        h = (h << 31) | (h >> 33);
+        return h * 0x9E3779B185EBCA87ULL;
+    }
+
+    using InputElements = std::vector<D3D12_INPUT_ELEMENT_DESC>;
+
+    struct LayoutRegistry
+    {
+        std::mutex mutex;
+        std::deque<InputElements> layouts; /// Stable addresses
+        HashMap<uint64, std::vector<const InputElements*>> table; /// Equal hashes, different layouts
+    };
+
+    LayoutRegistry& layoutRegistry()
+    {
+        static LayoutRegistry r;
+        return r;
+    }
+
+    bool sameElement(const D3D12_INPUT_ELEMENT_DESC& a, const D3D12_INPUT_ELEMENT_DESC& b)
+    {
+        return std::strcmp(a.SemanticName, b.SemanticName) == 0 && a.SemanticIndex == b.SemanticIndex &&
+            a.Format == b.Format && a.InputSlot == b.InputSlot && a.AlignedByteOffset == b.AlignedByteOffset &&
+            a.InputSlotClass == b.InputSlotClass && a.InstanceDataStepRate == b.InstanceDataStepRate;
+    }
+
+    bool sameLayout(const InputElements& a, const D3D12_INPUT_LAYOUT_DESC& b)
+    {
+        return a.size() == b.NumElements &&
+            std::equal(std::begin(a), std::end(a), b.pInputElementDescs, sameElement);
+    }
+}
+
+uint64 hashShaderBytecode(const D3D12_SHADER_BYTECODE& code) noexcept
+{
+    if (!code.pShaderBytecode || code.BytecodeLength == 0)
+    {
+        return 0;
+    }
+    return hash64(code.pShaderBytecode, code.BytecodeLength);
+}
+
+uint64 hashInputLayout(const D3D12_INPUT_LAYOUT_DESC& layout) noexcept
+{
+    auto h = hash64(nullptr, 0, layout.NumElements);
+    for (UINT i = 0; i < layout.NumElements; ++i)
+    {
+        const auto& elem = layout.pInputElementDescs[i];
+        h = mix(h, hash64(elem.SemanticName, std::strlen(elem.SemanticName)));
+        h = mix(h, elem.SemanticIndex);
+        h = mix(h, elem.Format);
+        h = mix(h, elem.InputSlot);
+        h = mix(h, elem.AlignedByteOffset);
+        h = mix(h, elem.InputSlotClass);
+        h = mix(h, elem.InstanceDataStepRate);
+    }
+    return h;
+}
+
+D3D12_INPUT_LAYOUT_DESC internInputLayout(const D3D12_INPUT_LAYOUT_DESC& layout, uint64 hash)
+{
+    auto& r = layoutRegistry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    auto& candidates = r.table[hash];
+    auto found = std::find_if(std::begin(candidates), std::end(candidates),
+        [&](const InputElements* elems) { return sameLayout(*elems, layout); });
+    if (found == std::end(candidates))
+    {
+        r.layouts.emplace_back(layout.pInputElementDescs, layout.pInputElementDescs + layout.NumElements);
+        candidates.push_back(&r.layouts.back());
+        found = std::end(candidates) - 1;
+    }
+
+    D3D12_INPUT_LAYOUT_DESC interned = {};
+    interned.pInputElementDescs = (*found)->data();
+    interned.NumElements = layout.NumElements;
+    return interned;
+}
+
+uint64 hashShaderState(const PipelineStateKey& key) noexcept
+{
+    const auto& s = key.state;
+    auto h = hash64(&s.BlendState, sizeof(s.BlendState), key.vs);
+    h = mix(h, key.gs);
+    h = mix(h, key.ps);
+    h = mix(h, hash64(&s.RasterizerState, sizeof(s.RasterizerState)));
+    h = mix(h, hash64(&s.DepthStencilState, sizeof(s.DepthStencilState)));
+    h = mix(h, s.SampleMask);
+    return h;
+}
+
+uint64 hashTargetState(const PipelineStateKey& key, uint64 shaderStateHash) noexcept
+{
+    const auto& s = key.state;
+    auto h = mix(shaderStateHash, key.inputLayout);
+    h = mix(h, s.IBStripCutValue);
+    h = mix(h, s.PrimitiveTopologyType);
+    h = mix(h, s.NumRenderTargets);
+    for (UINT i = 0; i < s.NumRenderTargets; ++i)
+    {
+        h = mix(h, s.RTVFormats[i]);
+    }
+    h = mix(h, s.DSVFormat);
+    h = mix(h, s.SampleDesc.Count);
+    h = mix(h, s.SampleDesc.Quality);
+    h = mix(h, s.NodeMask);
+    h = mix(h, s.Flags);
+    return h;
+}
+
+bool operator ==(const PipelineStateKey& a, const PipelineStateKey& b) noexcept
+{
+    return a.hash == b.hash && a.vs == b.vs && a.gs == b.gs && a.ps == b.ps && a.inputLayout == b.inputLayout &&
+        std::memcmp(&a.state, &b.state, sizeof(a.state)) == 0;
+}
+
+bool operator !=(const PipelineStateKey& a, const PipelineStateKey& b) noexcept
+{
+    return !(a == b);
+}
+
+GF_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef GAMEFRIENDS_PIPELINEKEY_H
+#define GAMEFRIENDS_PIPELINEKEY_H
+
+#include "../windowing/windowsinc.h"
+#include "foundation/prerequest.h"
+#include <d3d12.h>
+
+GF_NAMESPACE_BEGIN
+
+/// 0 for an empty stage
+uint64 hashShaderBytecode(const D3D12_SHADER_BYTECODE& code) noexcept;
+
+/// Includes the semantic names
+uint64 hashInputLayout(const D3D12_INPUT_LAYOUT_DESC& layout) noexcept;
+
+/// Returns layout with its elements copied to storage shared by every equal layout and kept
+/// until shutdown, so the element pointer identifies the layout. hash is hashInputLayout(layout).
+D3D12_INPUT_LAYOUT_DESC internInputLayout(const D3D12_INPUT_LAYOUT_DESC& layout, uint64 hash) noexcept(false);
+
+/// Everything a pipeline state object is made from, compared bytewise.
+/// The shader stages keep their bytecode pointer and length and the input layout is interned,
+/// so equal keys use the same shaders and layout. Only the root signature pointer is null;
+/// it follows from the shaders.
+/// vs, gs, ps and inputLayout are content hashes for the hash only. hash is not computed here;
+/// OptimizedDrawCall keeps it up to date with its setters.
+struct PipelineStateKey
+{
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC state;
+    uint64 vs;
+    uint64 gs;
+    uint64 ps;
+    uint64 inputLayout;
+    uint64 hash;
+};
+
+/// Hash of the part fixed when a shade model is loaded (shaders, blend, rasterizer, depth stencil)
+uint64 hashShaderState(const PipelineStateKey& key) noexcept;
+
+/// Mixes shaderStateHash with the part a draw call sets per frame (input layout, topology, targets).
+/// Only a few words, so it is cheap enough for every draw.
+uint64 hashTargetState(const PipelineStateKey& key, uint64 shaderStateHash) noexcept;
+
+bool operator ==(const PipelineStateKey& a, const PipelineStateKey& b) noexcept;
+bool operator !=(const PipelineStateKey& a, const PipelineStateKey& b) noexcept;
+
+/// For unordered containers. Returns the precomputed hash.
+struct PrecomputedHash
+{
+    template <class Key>
+    size_t operator ()(const Key& key) const noexcept
+    {
+        return static_cast<size_t>(key.hash);
+    }
+};
+
+GF_NAMESPACE_END
+
+#endif
\ No newline at end of file
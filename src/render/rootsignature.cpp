@@ -2,15 +2,14 @@
 #include "rendersystem.h"
 #include "d3dsupport.h"
 #include "../engine/logging.h"
-#include "foundation/math.h"
+#include "foundation/smallvector.h"
 #include <array>
-#include <vector>
 
 GF_NAMESPACE_BEGIN
 
-ID3D12RootSignature& RootSignatureObtain::operator()(const EachShaderSignature& sig) const
+ID3D12RootSignature& RootSignatureObtain::operator()(const RootSignatureKey& key) const
 {
-    return renderSystem.rootSignatures().obtain(sig);
+    return renderSystem.rootSignatures().obtain(key);
 }
 
 void RootSignatureCache::construct(ID3D12Device* device)
@@ -24,16 +23,15 @@ void RootSignatureCache::destruct()
     device_ = nullptr;
 }
 
-ID3D12RootSignature& RootSignatureCache::obtain(const EachShaderSignature& key)
+ID3D12RootSignature& RootSignatureCache::obtain(const RootSignatureKey& key)
 {
-    const auto hashCode = crc32(&key, sizeof(key));
-    auto& obj = table_[hashCode];
+    auto& obj = table_[key];
     if (!obj)
     {
         const std::array<const ShaderSignature*, 3> priority = {
-            &key.vs,
-            &key.gs,
-            &key.ps
+            &key.signature.vs,
+            &key.signature.gs,
+            &key.signature.ps
         };
         const std::array<D3D12_SHADER_VISIBILITY, 3> visibility = {
             D3D12_SHADER_VISIBILITY_VERTEX,
@@ -52,11 +50,9 @@ ID3D12RootSignature& RootSignatureCache::obtain(const EachShaderSignature& key)
             D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS |
             D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS;
 
-        std::vector<CD3DX12_ROOT_PARAMETER> rootParams;
-        std::vector<CD3DX12_DESCRIPTOR_RANGE> ranges;
-
-        rootParams.reserve(NUM_HEAPS_PER_SHADER * priority.size());
-        ranges.reserve(NUM_RANGES_PER_SHADER * priority.size());
+        // Tables point into ranges, which never outgrows its inline storage
+        SmallVector<CD3DX12_ROOT_PARAMETER, NUM_HEAPS_PER_SHADER * 3> rootParams;
+        SmallVector<CD3DX12_DESCRIPTOR_RANGE, NUM_RANGES_PER_SHADER * 3> ranges;
 
         for (unsigned i = 0; i < priority.size(); ++i)
         {
@@ -67,35 +63,35 @@ ID3D12RootSignature& RootSignatureCache::obtain(const EachShaderSignature& key)
 
             if (sig->cbv > 0)
             {
-                ranges.emplace_back(
+                ranges.emplaceBack(
                     CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, sig->cbv, 0));
                 ++numBufferRanges;
             }
 
             if (sig->srv > 0)
             {
-                ranges.emplace_back(
+                ranges.emplaceBack(
                     CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, sig->srv, 0));
                 ++numBufferRanges;
             }
 
             if (numBufferRanges > 0)
             {
-                rootParams.emplace_back();
+                rootParams.emplaceBack();
                 CD3DX12_ROOT_PARAMETER::InitAsDescriptorTable(rootParams.back(),
                     numBufferRanges, ranges.data() + ranges.size() - numBufferRanges, visibility[i]);
             }
 
             if (sig->sampler > 0)
             {
-                ranges.emplace_back(
+                ranges.emplaceBack(
                     CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER, sig->sampler, 0));
                 ++numSamplerRanges;
             }
 
             if (numSamplerRanges > 0)
             {
-                rootParams.emplace_back();
+                rootParams.emplaceBack();
                 CD3DX12_ROOT_PARAMETER::InitAsDescriptorTable(rootParams.back(),
                     numSamplerRanges, ranges.data() + ranges.size() - numSamplerRanges, visibility[i]);
             }
@@ -1,10 +1,13 @@
 #ifndef GAMEFRIENDS_ROOTSIGNATURE_H
 #define GAMEFRIENDS_ROOTSIGNATURE_H
 
+#include "pipelinekey.h"
 #include "../windowing/windowsinc.h"
+#include "foundation/hashmap.h"
+#include "foundation/math.h"
 #include "foundation/prerequest.h"
 #include <d3d12.h>
-#include <unordered_map>
+#include <cstring>
 
 GF_NAMESPACE_BEGIN
 
@@ -25,16 +28,40 @@ struct EachShaderSignature
     ShaderSignature ps;
 };
 
+struct RootSignatureKey
+{
+    EachShaderSignature signature;
+    uint64 hash;
+};
+
+inline RootSignatureKey makeRootSignatureKey(const EachShaderSignature& signature) noexcept
+{
+    RootSignatureKey key;
+    key.signature = signature;
+    key.hash = hash64(&signature, sizeof(signature));
+    return key;
+}
+
+inline bool operator ==(const RootSignatureKey& a, const RootSignatureKey& b) noexcept
+{
+    return a.hash == b.hash && std::memcmp(&a.signature, &b.signature, sizeof(a.signature)) == 0;
+}
+
+inline bool operator !=(const RootSignatureKey& a, const RootSignatureKey& b) noexcept
+{
+    return !(a == b);
+}
+
 struct RootSignatureObtain
 {
-    ID3D12RootSignature& operator ()(const EachShaderSignature& sig) const noexcept(false);
+    ID3D12RootSignature& operator ()(const RootSignatureKey& key) const noexcept(false);
 };
 
 class RootSignatureCache
 {
 private:
     ID3D12Device* device_;
-    std::unordered_map<unsigned, ComPtr<ID3D12RootSignature>> table_;
+    HashMap<RootSignatureKey, ComPtr<ID3D12RootSignature>, PrecomputedHash> table_;
 
 public:
     void construct(ID3D12Device* device);
@@ -44,7 +71,7 @@ public:
     RootSignatureCache(const RootSignatureCache&) = delete;
     RootSignatureCache& operator =(const RootSignatureCache&) = delete;
 
-    ID3D12RootSignature& obtain(const EachShaderSignature& key) noexcept(false);
+    ID3D12RootSignature& obtain(const RootSignatureKey& key) noexcept(false);
 };
 
 GF_NAMESPACE_END
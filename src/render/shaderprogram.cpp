@@ -34,9 +34,6 @@ ShaderParameters::ShaderParameters(ID3D12ShaderReflection* vs, ID3D12ShaderRefle
         ShaderInfo{ ps, &signatures.ps, &bindingMap_[2] }
     };
 
-    descriptorHeaps_.reserve(2);
-    rootParameters_.reserve(NUM_HEAPS_PER_SHADER * priority.size());
-
     size_t sizeOfBufferHeap = 0;
     size_t sizeOfSamplerHeap = 0;
     for (unsigned i = 0; i < priority.size(); ++i)
@@ -51,12 +48,12 @@ ShaderParameters::ShaderParameters(ID3D12ShaderReflection* vs, ID3D12ShaderRefle
     if (sizeOfBufferHeap > 0)
     {
         bufferHeap = DescriptorAllocator(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)(sizeOfBufferHeap, true);
-        descriptorHeaps_.emplace_back(bufferHeap.heap);
+        descriptorHeaps_.emplaceBack(bufferHeap.heap);
     }
     if (sizeOfSamplerHeap > 0)
     {
         samplerHeap = DescriptorAllocator(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER)(sizeOfSamplerHeap, true);
-        descriptorHeaps_.emplace_back(samplerHeap.heap);
+        descriptorHeaps_.emplaceBack(samplerHeap.heap);
     }
 
     for (unsigned i = 0; i < priority.size(); ++i)
@@ -69,19 +66,19 @@ ShaderParameters::ShaderParameters(ID3D12ShaderReflection* vs, ID3D12ShaderRefle
 
         if (sig->cbv + sig->srv > 0)
         {
-            rootParameters_.emplace_back(bufferHeap.gpuAt);
+            rootParameters_.emplaceBack(bufferHeap.gpuAt);
             bufferHeap = bufferHeap.next(sig->cbv + sig->srv);
         }
 
         if (sig->sampler > 0)
         {
-            rootParameters_.emplace_back(samplerHeap.gpuAt);
+            rootParameters_.emplaceBack(samplerHeap.gpuAt);
             samplerHeap = samplerHeap.next(sig->sampler);
         }
     }
 }
 
-void ShaderParameters::updateConstant(ShaderType type, const std::string& name, const void* data, size_t size)
+void ShaderParameters::updateConstant(ShaderType type, StringId name, const void* data, size_t size)
 {
     const auto found = bindingMap_[index(type)].var.find(name);
     if (found != std::cend(bindingMap_[index(type)].var))
@@ -91,7 +88,7 @@ void ShaderParameters::updateConstant(ShaderType type, const std::string& name,
     }
 }
 
-void ShaderParameters::updateShaderResource(ShaderType type, const std::string& name, PixelBuffer& resource)
+void ShaderParameters::updateShaderResource(ShaderType type, StringId name, PixelBuffer& resource)
 {
     const auto found = bindingMap_[index(type)].sr.find(name);
     if (found != std::cend(bindingMap_[index(type)].sr))
@@ -102,6 +99,16 @@ void ShaderParameters::updateShaderResource(ShaderType type, const std::string&
     }
 }
 
+void ShaderParameters::updateConstant(ShaderType type, StringRef name, const void* data, size_t size)
+{
+    updateConstant(type, StringId(name), data, size);
+}
+
+void ShaderParameters::updateShaderResource(ShaderType type, StringRef name, PixelBuffer& resource)
+{
+    updateShaderResource(type, StringId(name), resource);
+}
+
 void ShaderParameters::createBindingMap(ID3D12ShaderReflection* shader, const ShaderSignature& sig,
     Descriptor bufferHeap, Descriptor samplerHeap, BindingMap& out)
 {
@@ -155,7 +162,7 @@ void ShaderParameters::createBindingMap(ID3D12ShaderReflection* shader, const Sh
             view.SizeInBytes = static_cast<UINT>(resourceDesc.Width);
             renderSystem.nativeDevice().CreateConstantBufferView(&view, bufferHolder.location.cpuAt);
 
-            out.cbuf.emplace(bindDesc.Name, bufferHolder);
+            out.cbuf.emplace(StringId::intern(bindDesc.Name), bufferHolder);
 
             char* mappedData;
             hr = resource->Map(0, nullptr, reinterpret_cast<void**>(&mappedData));
@@ -179,7 +186,7 @@ void ShaderParameters::createBindingMap(ID3D12ShaderReflection* shader, const Sh
                     std::memcpy(var.ptr, varDesc.DefaultValue, var.size);
                 }
 
-                out.var.emplace(varDesc.Name, var);
+                out.var.emplace(StringId::intern(varDesc.Name), var);
             }
 
             break;
@@ -188,7 +195,7 @@ void ShaderParameters::createBindingMap(ID3D12ShaderReflection* shader, const Sh
         case D3D_SIT_TEXTURE: {
             ShaderResource sr;
             sr.location = bufferHeap.next(sig.cbv + bindDesc.BindPoint);
-            out.sr.emplace(bindDesc.Name, sr);
+            out.sr.emplace(StringId::intern(bindDesc.Name), sr);
             break;
         }
 
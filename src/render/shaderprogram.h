@@ -8,6 +8,10 @@
 #include "../engine/filesystem.h"
 #include "../windowing/windowsinc.h"
 #include "foundation/sortedvector.h"
+#include "foundation/smallvector.h"
+#include "foundation/hashmap.h"
+#include "foundation/stringref.h"
+#include "foundation/stringid.h"
 #include "foundation/prerequest.h"
 #include <d3d12.h>
 #include <d3dcompiler.h>
@@ -16,7 +20,6 @@
 #include <array>
 #include <initializer_list>
 #include <utility>
-#include <unordered_map>
 #include <cstring>
 
 GF_NAMESPACE_BEGIN
@@ -59,21 +62,23 @@ private:
 
     struct BindingMap
     {
-        std::unordered_map<std::string, ConstantBuffer> cbuf;
-        std::unordered_map<std::string, Variable> var;
-        std::unordered_map<std::string, ShaderResource> sr;
+        HashMap<StringId, ConstantBuffer> cbuf;
+        HashMap<StringId, Variable> var;
+        HashMap<StringId, ShaderResource> sr;
     };
 
     std::array<BindingMap, 3> bindingMap_;
-    std::vector<ID3D12DescriptorHeap*> descriptorHeaps_;
-    std::vector<D3D12_GPU_DESCRIPTOR_HANDLE> rootParameters_;
+    SmallVector<ID3D12DescriptorHeap*, 2> descriptorHeaps_; /// CBV_SRV_UAV, SAMPLER
+    SmallVector<D3D12_GPU_DESCRIPTOR_HANDLE, NUM_HEAPS_PER_SHADER * 3> rootParameters_;
 
 public:
     ShaderParameters(ID3D12ShaderReflection* vs, ID3D12ShaderReflection* gs, ID3D12ShaderReflection* ps,
         const EachShaderSignature& signatures);
 
-    void updateConstant(ShaderType type, const std::string& name, const void* data, size_t size);
-    void updateShaderResource(ShaderType type, const std::string& name, PixelBuffer& resource);
+    void updateConstant(ShaderType type, StringId name, const void* data, size_t size);
+    void updateConstant(ShaderType type, StringRef name, const void* data, size_t size);
+    void updateShaderResource(ShaderType type, StringId name, PixelBuffer& resource);
+    void updateShaderResource(ShaderType type, StringRef name, PixelBuffer& resource);
 
     auto usedDescriptorHeaps() const -> decltype(std::make_pair(std::cbegin(descriptorHeaps_), std::cend(descriptorHeaps_)))
     {
@@ -122,7 +127,7 @@ private:
         ComPtr<ID3DBlob> code;
         ComPtr<ID3D12ShaderReflection> ref;
     };
-    std::unordered_map<std::string, ShaderHold> compiledShaders_;
+    HashMap<std::string, ShaderHold> compiledShaders_;
 
 public:
     HLSLShader(const EnginePath& path);
@@ -2,30 +2,39 @@
 #include "linearallocator.h"
 #include "rendersystem.h"
 #include "d3dsupport.h"
+#include "pipelinekey.h"
 #include "foundation/exception.h"
+#include "foundation/frameallocator.h"
 #include "../engine/logging.h"
 #include <algorithm>
 #include <cstring>
 
 GF_NAMESPACE_BEGIN
 
-const std::string Semantics::POSITION = "POSITION";
-const std::string Semantics::COLOR = "COLOR";
-const std::string Semantics::NORMAL = "NORMAL";
-const std::string Semantics::TEXCOORD = "TEXCOORD";
+const StringId Semantics::POSITION = StringId::intern("POSITION");
+const StringId Semantics::COLOR = StringId::intern("COLOR");
+const StringId Semantics::NORMAL = StringId::intern("NORMAL");
+const StringId Semantics::TEXCOORD = StringId::intern("TEXCOORD");
 
-void VertexData::setVertices(const std::string& semantics, size_t index, const void* data, size_t size, PixelFormat format)
+void VertexData::setStagingAllocator(FrameAllocator& frame)
+{
+    staging_ = &frame;
+}
+
+void VertexData::setVertices(StringRef semantics, size_t index, const void* data, size_t size, PixelFormat format)
+{
+    setVertices(StringId::intern(semantics), index, data, size, format);
+}
+
+void VertexData::setVertices(StringId semantics, size_t index, const void* data, size_t size, PixelFormat format)
 {
     VertexBuffer key;
     key.semantics = semantics;
+    key.semanticName = semantics.name();
     key.index = index;
+    check(key.semanticName);
 
-    auto r = std::equal_range(std::begin(vertices_), std::end(vertices_), key, vertices_.comp());
-    if (r.first == r.second)
-    {
-         r.first = vertices_.insert(key);
-    }
-    const auto found = r.first;
+    const auto found = vertices_.insertUnique(key).first;
 
     const auto defaultHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
     const auto desc = CD3DX12_RESOURCE_DESC::Buffer(size);
@@ -43,8 +52,7 @@ void VertexData::setVertices(const std::string& semantics, size_t index, const v
     found->buffer = makeComPtr(buffer);
     found->format = format;
     found->dataSize = size;
-    found->uploadData.reset(new char[size]);
-    std::memcpy(found->uploadData.get(), data, size);
+    found->uploadData = stage(data, size);
 
     vertexBufferViews_.clear();
     inputElems_.clear();
@@ -58,20 +66,26 @@ void VertexData::setVertices(const std::string& semantics, size_t index, const v
         view.BufferLocation = v.buffer->GetGPUVirtualAddress();
         view.SizeInBytes = v.dataSize;
         view.StrideInBytes = sizeofPixelFormat(v.format);
-        vertexBufferViews_.emplace_back(view);
+        vertexBufferViews_.emplaceBack(view);
 
         D3D12_INPUT_ELEMENT_DESC elem = {};
-        elem.SemanticName = v.semantics.c_str();
+        elem.SemanticName = v.semanticName;
         elem.SemanticIndex = v.index;
         elem.Format = D3DMappings::DXGI_FORMAT_(v.format);
         elem.InputSlot = i;
         elem.AlignedByteOffset = 0;
         elem.InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
         elem.InstanceDataStepRate = 0;
-        inputElems_.emplace_back(elem);
+        inputElems_.emplaceBack(elem);
 
         ++i;
     }
+
+    D3D12_INPUT_LAYOUT_DESC layout = {};
+    layout.NumElements = inputElems_.size();
+    layout.pInputElementDescs = inputElems_.data();
+    inputLayoutHash_ = hashInputLayout(layout);
+    inputLayout_ = internInputLayout(layout, inputLayoutHash_);
 }
 
 void VertexData::setIndices(const unsigned short* data, size_t size)
@@ -91,8 +105,7 @@ void VertexData::setIndices(const unsigned short* data, size_t size)
 
     indices_.buffer = makeComPtr(buffer);
     indices_.dataSize = size;
-    indices_.uploadData.reset(new char[size]);
-    std::memcpy(indices_.uploadData.get(), data, size);
+    indices_.uploadData = stage(data, size);
 
     indices_.view.BufferLocation = buffer->GetGPUVirtualAddress();
     indices_.view.SizeInBytes = size;
@@ -114,20 +127,20 @@ void VertexData::upload(ID3D12GraphicsCommandList& list)
         D3D12_RESOURCE_STATES afterState;
     };
 
-    std::vector<Upload> uploads;
+    SmallVector<Upload, INLINE_STREAMS + 1> uploads;
 
     for (auto& v : vertices_)
     {
         if (v.uploadData)
         {
             const auto dest = v.buffer.get();
-            uploads.emplace_back(Upload{ dest, v.uploadData, v.dataSize, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER });
+            uploads.emplaceBack(Upload{ dest, v.uploadData, v.dataSize, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER });
         }
     }
     if (indices_.uploadData)
     {
         const auto dest = indices_.buffer.get();
-        uploads.emplace_back(Upload{ dest, indices_.uploadData, indices_.dataSize, D3D12_RESOURCE_STATE_INDEX_BUFFER });
+        uploads.emplaceBack(Upload{ dest, indices_.uploadData, indices_.dataSize, D3D12_RESOURCE_STATE_INDEX_BUFFER });
     }
 
     if (!uploads.empty())
@@ -150,7 +163,7 @@ void VertexData::upload(ID3D12GraphicsCommandList& list)
                 GF_LOG_WARN("Failed to vertex data completely uploading.");
             }
 
-            barriers_.emplace_back(CD3DX12_RESOURCE_BARRIER::Transition(u.dest, D3D12_RESOURCE_STATE_COPY_DEST, u.afterState));
+            barriers_.emplaceBack(CD3DX12_RESOURCE_BARRIER::Transition(u.dest, D3D12_RESOURCE_STATE_COPY_DEST, u.afterState));
 
             u.srcData.reset();
         }
@@ -178,10 +191,29 @@ D3D12_PRIMITIVE_TOPOLOGY VertexData::primitiveTopology() const
 
 D3D12_INPUT_LAYOUT_DESC VertexData::inputLayout() const
 {
-    D3D12_INPUT_LAYOUT_DESC il = {};
-    il.NumElements = inputElems_.size();
-    il.pInputElementDescs = inputElems_.data();
-    return il;
+    return inputLayout_;
+}
+
+uint64 VertexData::inputLayoutHash() const
+{
+    return inputLayoutHash_;
+}
+
+std::shared_ptr<void> VertexData::stage(const void* data, size_t size)
+{
+    if (!staging_)
+    {
+        std::shared_ptr<char> copy(new char[size], std::default_delete<char[]>());
+        std::memcpy(copy.get(), data, size);
+        return copy;
+    }
+
+    // The control block goes to frame memory too
+    const auto frame = staging_;
+    const auto copy = frame->allocate(size, alignof(float));
+    std::memcpy(copy, data, size);
+    return std::shared_ptr<void>(copy, [frame, size](void* p) { frame->deallocate(p, size); },
+        FrameStdAllocator<char>(*frame));
 }
 
 GF_NAMESPACE_END
\ No newline at end of file
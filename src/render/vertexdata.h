@@ -4,20 +4,25 @@
 #include "../windowing/windowsinc.h"
 #include "../engine/pixelformat.h"
 #include "foundation/sortedvector.h"
+#include "foundation/smallvector.h"
+#include "foundation/stringref.h"
+#include "foundation/stringid.h"
 #include "foundation/prerequest.h"
 #include <d3d12.h>
 #include <string>
-#include <vector>
+#include <memory>
 #include <utility>
 
 GF_NAMESPACE_BEGIN
 
+class FrameAllocator;
+
 struct Semantics
 {
-    static const std::string POSITION;
-    static const std::string COLOR;
-    static const std::string NORMAL;
-    static const std::string TEXCOORD;
+    static const StringId POSITION;
+    static const StringId COLOR;
+    static const StringId NORMAL;
+    static const StringId TEXCOORD;
 };
 
 enum class PrimitiveTopology
@@ -33,7 +38,8 @@ class VertexData
 private:
     struct VertexBuffer
     {
-        std::string semantics;
+        StringId semantics;
+        const char* semanticName; /// Interned
         size_t index;
         PixelFormat format;
         ComPtr<ID3D12Resource> buffer;
@@ -49,7 +55,7 @@ private:
             {
                 return a.index < b.index;
             }
-            return a.semantics < b.semantics;
+            return a.semantics < b.semantics; /// Hash order
         }
     };
 
@@ -65,12 +71,24 @@ private:
     IndexBuffer indices_;
     D3D12_PRIMITIVE_TOPOLOGY topology_;
 
-    std::vector<D3D12_RESOURCE_BARRIER> barriers_;
-    std::vector<D3D12_VERTEX_BUFFER_VIEW> vertexBufferViews_;
-    std::vector<D3D12_INPUT_ELEMENT_DESC> inputElems_;
+    /// Sized for the usual handful of streams, more spill to the heap
+    static const size_t INLINE_STREAMS = 8;
+
+    SmallVector<D3D12_RESOURCE_BARRIER, INLINE_STREAMS + 1> barriers_;
+    SmallVector<D3D12_VERTEX_BUFFER_VIEW, INLINE_STREAMS> vertexBufferViews_;
+    SmallVector<D3D12_INPUT_ELEMENT_DESC, INLINE_STREAMS> inputElems_;
+    D3D12_INPUT_LAYOUT_DESC inputLayout_ = {}; /// Interned
+    uint64 inputLayoutHash_ = 0;
+    FrameAllocator* staging_ = nullptr;
 
 public:
-    void setVertices(const std::string& semantics, size_t index, const void* data, size_t size, PixelFormat format);
+    /// The copies setVertices and setIndices keep until upload go to frame memory instead of the heap.
+    /// upload must then run in this frame or the next.
+    void setStagingAllocator(FrameAllocator& frame);
+
+    /// semantics must be interned
+    void setVertices(StringId semantics, size_t index, const void* data, size_t size, PixelFormat format);
+    void setVertices(StringRef semantics, size_t index, const void* data, size_t size, PixelFormat format);
     void setIndices(const unsigned short* data, size_t size);
     void setTopology(PrimitiveTopology pt);
     void upload(ID3D12GraphicsCommandList& list);
@@ -84,7 +102,11 @@ public:
 
     D3D12_INDEX_BUFFER_VIEW indexBuffer() const;
     D3D12_PRIMITIVE_TOPOLOGY primitiveTopology() const;
-    D3D12_INPUT_LAYOUT_DESC inputLayout() const;
+    D3D12_INPUT_LAYOUT_DESC inputLayout() const; /// Interned, equal layouts share the elements
+    uint64 inputLayoutHash() const; /// Updated with the layout
+
+private:
+    std::shared_ptr<void> stage(const void* data, size_t size);
 };
 
 GF_NAMESPACE_END
@@ -8,6 +8,9 @@
 #include "../engine/pixelformat.h"
 #include "../engine/logging.h"
 #include "foundation/matrix44.h"
+#include "foundation/axisalignedbox.h"
+#include "foundation/batchtransform.h"
+#include "foundation/frameallocator.h"
 
 GF_NAMESPACE_BEGIN
 
@@ -42,12 +45,17 @@ void DebugDraw::shutdown()
 
 void DebugDraw::drawDebugs(const RenderCamera& camera)
 {
+    // The previous frame's vertices live in frame memory, so they must not be kept beyond this frame
+    vertex_.reset();
+
     if (positions_.empty() || !material_.useable())
     {
         return;
     }
 
-    vertex_ = std::make_shared<VertexData>();
+    auto& frame = sceneAppContext.frameAllocator();
+    vertex_ = std::allocate_shared<VertexData>(FrameStdAllocator<VertexData>(frame));
+    vertex_->setStagingAllocator(frame);
     vertex_->setTopology(PrimitiveTopology::lines);
     vertex_->setVertices(Semantics::POSITION, 0, positions_.data(),  positions_.size() * sizeof(Vector3), PixelFormat::RGB32_float);
     vertex_->setVertices(Semantics::COLOR, 0, colors_.data(), colors_.size() * sizeof(Color), PixelFormat::RGBA32_float);
@@ -80,6 +88,28 @@ void DebugDraw::line(const Vector3& from, const Vector3& to, const Color& color)
     colors_.emplace_back(color);
 }
 
+void DebugDraw::box(const AxisAlignedBox& box, const Matrix44& world, const Color& color)
+{
+    Vector3 corners[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        corners[i] = box.corner(i);
+    }
+    transformPoints(world, corners, corners, 8);
+
+    // Edges connect corners whose indices differ in one bit
+    for (int i = 0; i < 8; ++i)
+    {
+        for (int bit = 1; bit < 8; bit <<= 1)
+        {
+            if (!(i & bit))
+            {
+                line(corners[i], corners[i | bit], color);
+            }
+        }
+    }
+}
+
 DebugDraw debugDraw;
 
 GF_NAMESPACE_END
\ No newline at end of file
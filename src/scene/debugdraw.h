@@ -11,6 +11,8 @@
 GF_NAMESPACE_BEGIN
 
 class Material;
+class Matrix44;
+struct AxisAlignedBox;
 struct RenderCamera;
 class VertexData;
 
@@ -27,6 +29,7 @@ public:
     void shutdown();
 
     void line(const Vector3& from, const Vector3& to, const Color& color);
+    void box(const AxisAlignedBox& box, const Matrix44& world, const Color& color);
 
     void drawDebugs(const RenderCamera& camera);
 };
@@ -15,47 +15,82 @@ Material::Material(const EnginePath& path)
 {
 }
 
-void Material::setFloat(const std::string& name, float f)
+void Material::setFloat(StringId name, float f)
 {
     setNumeric(MatParamType::_float, name, &f, sizeof(f));
 }
 
-void Material::setFloat(const std::string& name, double f)
+void Material::setFloat(StringId name, double f)
 {
     setFloat(name, static_cast<float>(f));
 }
 
-void Material::setFloat4(const std::string& name, const Vector4& f4)
+void Material::setFloat4(StringId name, const Vector4& f4)
 {
     setNumeric(MatParamType::_float4, name, &f4, sizeof(f4));
 }
 
-void Material::setFloat4(const std::string& name, const Color& f4)
+void Material::setFloat4(StringId name, const Color& f4)
 {
     setNumeric(MatParamType::_float4, name, &f4, sizeof(f4));
 }
 
-void Material::setFloat4x4(const std::string& name, const Matrix44& f44)
+void Material::setFloat4x4(StringId name, const Matrix44& f44)
 {
     setNumeric(MatParamType::_float4x4, name, &f44, sizeof(f44));
 }
 
-void Material::setTex2D(const std::string& name, const ResourceInterface<MediaTexture>& texture)
+void Material::setTex2D(StringId name, const ResourceInterface<MediaTexture>& texture)
 {
     setTexture(MatParamType::_tex2d, name, texture);
 }
 
-void Material::directNumeric(ShaderType type, const std::string& name, const void* data, size_t size)
+void Material::directNumeric(ShaderType type, StringId name, const void* data, size_t size)
 {
     shadeModelIn_->directNumeric(type, name, data, size);
 }
 
+void Material::setFloat(StringRef name, float f)
+{
+    setFloat(StringId(name), f);
+}
+
+void Material::setFloat(StringRef name, double f)
+{
+    setFloat(StringId(name), f);
+}
+
+void Material::setFloat4(StringRef name, const Vector4& f4)
+{
+    setFloat4(StringId(name), f4);
+}
+
+void Material::setFloat4(StringRef name, const Color& f4)
+{
+    setFloat4(StringId(name), f4);
+}
+
+void Material::setFloat4x4(StringRef name, const Matrix44& f44)
+{
+    setFloat4x4(StringId(name), f44);
+}
+
+void Material::setTex2D(StringRef name, const ResourceInterface<MediaTexture>& texture)
+{
+    setTex2D(StringId(name), texture);
+}
+
+void Material::directNumeric(ShaderType type, StringRef name, const void* data, size_t size)
+{
+    directNumeric(type, StringId(name), data, size);
+}
+
 OptimizedDrawCall Material::drawCallSource() const
 {
     return shadeModelIn_->drawCallSource();
 }
 
-void Material::setNumeric(MatParamType type, const std::string& name, const void* data, size_t size)
+void Material::setNumeric(MatParamType type, StringId name, const void* data, size_t size)
 {
     if (paramCheck(type, name))
     {
@@ -63,7 +98,7 @@ void Material::setNumeric(MatParamType type, const std::string& name, const void
     }
 }
 
-void Material::setTexture(MatParamType type, const std::string& name, const ResourceInterface<MediaTexture>& texture)
+void Material::setTexture(MatParamType type, StringId name, const ResourceInterface<MediaTexture>& texture)
 {
     if (paramCheck(type, name) && texture.useable())
     {
@@ -71,7 +106,7 @@ void Material::setTexture(MatParamType type, const std::string& name, const Reso
     }
 }
 
-bool Material::paramCheck(MatParamType type, const std::string& name)
+bool Material::paramCheck(MatParamType type, StringId name)
 {
     const auto it = params_.find(name);
     if (it == std::cend(params_))
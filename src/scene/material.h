@@ -6,6 +6,9 @@
 #include "../render/drawcall.h"
 #include "../engine/resource.h"
 #include "../engine/filesystem.h"
+#include "foundation/hashmap.h"
+#include "foundation/stringref.h"
+#include "foundation/stringid.h"
 #include "foundation/prerequest.h"
 
 GF_NAMESPACE_BEGIN
@@ -26,27 +29,35 @@ private:
         ResourceInterface<MediaTexture> texture;
         std::shared_ptr<void> numeric;
     };
-    std::unordered_map<std::string, ParamHolder> params_;
+    HashMap<StringId, ParamHolder> params_;
     std::shared_ptr<ShadeModelInput> shadeModelIn_;
     ResourceInterface<const ShadeModel> shadeModel_;
 
 public:
     explicit Material(const EnginePath& path);
 
-    void setFloat(const std::string& name, float f);
-    void setFloat(const std::string& name, double f);
-    void setFloat4(const std::string& name, const Vector4& f4);
-    void setFloat4(const std::string& name, const Color& f4);
-    void setFloat4x4(const std::string& name, const Matrix44& f44);
-    void setTex2D(const std::string& name, const ResourceInterface<MediaTexture>& texture);
+    void setFloat(StringId name, float f);
+    void setFloat(StringId name, double f);
+    void setFloat4(StringId name, const Vector4& f4);
+    void setFloat4(StringId name, const Color& f4);
+    void setFloat4x4(StringId name, const Matrix44& f44);
+    void setTex2D(StringId name, const ResourceInterface<MediaTexture>& texture);
 
-    void directNumeric(ShaderType type, const std::string& name, const void* data, size_t size);
+    void setFloat(StringRef name, float f);
+    void setFloat(StringRef name, double f);
+    void setFloat4(StringRef name, const Vector4& f4);
+    void setFloat4(StringRef name, const Color& f4);
+    void setFloat4x4(StringRef name, const Matrix44& f44);
+    void setTex2D(StringRef name, const ResourceInterface<MediaTexture>& texture);
+
+    void directNumeric(ShaderType type, StringId name, const void* data, size_t size);
+    void directNumeric(ShaderType type, StringRef name, const void* data, size_t size);
     OptimizedDrawCall drawCallSource() const;
 
 private:
-    void setNumeric(MatParamType type, const std::string& name, const void* data, size_t size);
-    void setTexture(MatParamType type, const std::string& name, const ResourceInterface<MediaTexture>& texture);
-    bool paramCheck(MatParamType type, const std::string& name);
+    void setNumeric(MatParamType type, StringId name, const void* data, size_t size);
+    void setTexture(MatParamType type, StringId name, const ResourceInterface<MediaTexture>& texture);
+    bool paramCheck(MatParamType type, StringId name);
 
     bool loadImpl();
     void unloadImpl();
@@ -2,9 +2,9 @@
 
 GF_NAMESPACE_BEGIN
 
-const std::string SystemMatParam::WORLD = "_World";
-const std::string SystemMatParam::VIEW = "_View";
-const std::string SystemMatParam::PROJ = "_Proj";
+const StringId SystemMatParam::WORLD("_World");
+const StringId SystemMatParam::VIEW("_View");
+const StringId SystemMatParam::PROJ("_Proj");
 
 bool isNumeric(MatParamType type)
 {
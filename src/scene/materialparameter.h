@@ -1,6 +1,7 @@
 #ifndef GAMEFRIENDS_MATERIALPARAMETER_H
 #define GAMEFRIENDS_MATERIALPARAMETER_H
 
+#include "foundation/stringid.h"
 #include "foundation/prerequest.h"
 #include <string>
 
@@ -8,9 +9,9 @@ GF_NAMESPACE_BEGIN
 
 struct SystemMatParam
 {
-    static const std::string WORLD; // float4x4 _World;
-    static const std::string VIEW; // float4x4 _View;
-    static const std::string PROJ; // float4x4 _Proj;
+    static const StringId WORLD; // float4x3 _World; (mul(float4(pos, 1), _World))
+    static const StringId VIEW; // float4x4 _View;
+    static const StringId PROJ; // float4x4 _Proj;
 };
 
 enum class MatParamType
@@ -10,6 +10,7 @@ Mesh::Mesh(const EnginePath& path)
     : Resource(path)
     , vertexData_()
     , subMeshes_()
+    , bounds_(AxisAlignedBox::NEGATIVE)
 {
 }
 
@@ -20,12 +21,8 @@ void Mesh::setVertexData(const std::shared_ptr<VertexData>& vertexData)
 
 void Mesh::addSubMesh(const SubMesh& sm)
 {
-    const auto r = std::equal_range(std::begin(subMeshes_), std::end(subMeshes_), sm, subMeshes_.comp());
-    if (r.first == r.second)
-    {
-        subMeshes_.insert(sm);
-    }
-    else
+    const auto r = subMeshes_.insertUnique(sm);
+    if (!r.second)
     {
         *r.first = sm;
     }
@@ -33,8 +30,8 @@ void Mesh::addSubMesh(const SubMesh& sm)
 
 SubMesh& Mesh::subMesh(const std::string& name)
 {
-    const auto it = std::lower_bound(std::begin(subMeshes_), std::end(subMeshes_), SubMesh{ name }, subMeshes_.comp());
-    check(it != std::end(subMeshes_) && it->name == name);
+    const auto it = subMeshes_.find(SubMesh{ name });
+    check(it != std::end(subMeshes_));
     return *it;
 }
 
@@ -43,4 +40,14 @@ std::shared_ptr<VertexData> Mesh::vertexData()
     return vertexData_;
 }
 
+void Mesh::setBounds(const AxisAlignedBox& bounds)
+{
+    bounds_ = bounds;
+}
+
+const AxisAlignedBox& Mesh::bounds() const
+{
+    return bounds_;
+}
+
 GF_NAMESPACE_END
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "../engine/resource.h"
 #include "../engine/filesystem.h"
 #include "foundation/sortedvector.h"
+#include "foundation/axisalignedbox.h"
 #include "foundation/prerequest.h"
 #include <vector>
 #include <memory>
@@ -31,12 +32,13 @@ private:
     
     struct SubMeshComp
     {
-        bool operator()(const SubMesh& a, const SubMesh& b)
+        bool operator()(const SubMesh& a, const SubMesh& b) const
         {
             return a.name < b.name;
         }
     };
     SortedVector<SubMesh, SubMeshComp> subMeshes_;
+    AxisAlignedBox bounds_;
 
 public:
     explicit Mesh(const EnginePath& path);
@@ -48,6 +50,10 @@ public:
 
     std::shared_ptr<VertexData> vertexData();
 
+    /// Local space. AxisAlignedBox::NEGATIVE when unknown.
+    void setBounds(const AxisAlignedBox& bounds);
+    const AxisAlignedBox& bounds() const;
+
     auto subMeshes()
         -> decltype(std::make_pair(std::cbegin(subMeshes_), std::cend(subMeshes_)))
     {
@@ -57,6 +63,10 @@ public:
 private:
     bool loadImpl();
     void unloadImpl();
+
+    /// MetaPropFile or BinaryMetaPropFile
+    template <class File>
+    void loadFrom(const File& file);
 };
 
 GF_NAMESPACE_END
@@ -10,31 +10,127 @@
 #include "foundation/math.h"
 #include "foundation/color.h"
 #include "foundation/exception.h"
+#include "foundation/frustum.h"
 #include <queue>
+#include <cfloat>
 
 GF_NAMESPACE_BEGIN
 
 SceneAppContext sceneAppContext;
 
-void RenderWorld::addEntity(const std::shared_ptr<RenderEntity>& entity)
+namespace
 {
-    const auto notFound = std::cend(entities_);
-    const auto r = std::equal_range(std::cbegin(entities_), std::cend(entities_), entity, entities_.comp());
-    if (r.first == r.second)
-    {
-        entities_.insert(entity);
-    }
+    const AxisAlignedBox INFINITE_BOUNDS = { { -FLT_MAX, -FLT_MAX, -FLT_MAX }, { FLT_MAX, FLT_MAX, FLT_MAX } };
 }
 
-void RenderWorld::removeEntity(const std::shared_ptr<RenderEntity>& entity)
+RenderEntityHandle RenderWorld::addEntity(const RenderEntity& entity)
 {
-    const auto r = std::equal_range(std::cbegin(entities_), std::cend(entities_), entity, entities_.comp());
-    entities_.erase(r.first, r.second);
+    const auto handle = entities_.insert();
+    meshes_.push_back(entity.mesh);
+    worldMatrices_.push_back(entity.worldMatrix);
+    boundsMinX_.push_back(INFINITE_BOUNDS.minimum.x);
+    boundsMinY_.push_back(INFINITE_BOUNDS.minimum.y);
+    boundsMinZ_.push_back(INFINITE_BOUNDS.minimum.z);
+    boundsMaxX_.push_back(INFINITE_BOUNDS.maximum.x);
+    boundsMaxY_.push_back(INFINITE_BOUNDS.maximum.y);
+    boundsMaxZ_.push_back(INFINITE_BOUNDS.maximum.z);
+    boundsDirty_.push_back(1);
+    return handle;
+}
+
+void RenderWorld::removeEntity(RenderEntityHandle entity)
+{
+    if (!entities_.contains(entity))
+    {
+        return;
+    }
+
+    const auto i = entities_.erase(entity);
+    swapRemove(meshes_, i);
+    swapRemove(worldMatrices_, i);
+    swapRemove(boundsMinX_, i);
+    swapRemove(boundsMinY_, i);
+    swapRemove(boundsMinZ_, i);
+    swapRemove(boundsMaxX_, i);
+    swapRemove(boundsMaxY_, i);
+    swapRemove(boundsMaxZ_, i);
+    swapRemove(boundsDirty_, i);
 }
 
 void RenderWorld::clearEntities()
 {
     entities_.clear();
+    meshes_.clear();
+    worldMatrices_.clear();
+    boundsMinX_.clear();
+    boundsMinY_.clear();
+    boundsMinZ_.clear();
+    boundsMaxX_.clear();
+    boundsMaxY_.clear();
+    boundsMaxZ_.clear();
+    boundsDirty_.clear();
+}
+
+bool RenderWorld::containsEntity(RenderEntityHandle entity) const
+{
+    return entities_.contains(entity);
+}
+
+size_t RenderWorld::numEntities() const
+{
+    return entities_.size();
+}
+
+const ResourceInterface<Mesh>& RenderWorld::mesh(RenderEntityHandle entity) const
+{
+    return meshes_[entities_.denseIndex(entity)];
+}
+
+void RenderWorld::setMesh(RenderEntityHandle entity, const ResourceInterface<Mesh>& mesh)
+{
+    const auto i = entities_.denseIndex(entity);
+    meshes_[i] = mesh;
+    setBounds(i, INFINITE_BOUNDS);
+    boundsDirty_[i] = 1;
+}
+
+const Affine34& RenderWorld::worldMatrix(RenderEntityHandle entity) const
+{
+    return worldMatrices_[entities_.denseIndex(entity)];
+}
+
+void RenderWorld::setWorldMatrix(RenderEntityHandle entity, const Affine34& m)
+{
+    const auto i = entities_.denseIndex(entity);
+    worldMatrices_[i] = m;
+    boundsDirty_[i] = 1;
+}
+
+void RenderWorld::setBounds(size_t i, const AxisAlignedBox& box)
+{
+    boundsMinX_[i] = box.minimum.x;
+    boundsMinY_[i] = box.minimum.y;
+    boundsMinZ_[i] = box.minimum.z;
+    boundsMaxX_[i] = box.maximum.x;
+    boundsMaxY_[i] = box.maximum.y;
+    boundsMaxZ_[i] = box.maximum.z;
+}
+
+void RenderWorld::refreshBounds()
+{
+    const auto n = boundsDirty_.size();
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!boundsDirty_[i] || !meshes_[i].useable())
+        {
+            continue;
+        }
+
+        const auto& local = meshes_[i]->bounds();
+        const auto known = local.minimum.x <= local.maximum.x;
+        setBounds(i, known ? local.transform(to(worldMatrices_[i])) : INFINITE_BOUNDS);
+        boundsDirty_[i] = 0;
+    }
 }
 
 void RenderWorld::draw(const RenderCamera& camera)
@@ -48,16 +144,39 @@ void RenderWorld::draw(const RenderCamera& camera)
     const auto view_T = camera.view.transpose();
     const auto proj_T = camera.proj.transpose();
 
-    for (const auto& entity : entities_)
+    const auto numEntities = entities_.size();
+    if (numEntities == 0)
+    {
+        return;
+    }
+
+    refreshBounds();
+
+    AxisAlignedBoxArrays bounds;
+    bounds.minX = boundsMinX_.data();
+    bounds.minY = boundsMinY_.data();
+    bounds.minZ = boundsMinZ_.data();
+    bounds.maxX = boundsMaxX_.data();
+    bounds.maxY = boundsMaxY_.data();
+    bounds.maxZ = boundsMaxZ_.data();
+
+    visible_.resize((numEntities + 31) / 32);
+    cullBoxes(makeFrustum(camera.view * camera.proj), bounds, numEntities, visible_.data());
+
+    for (size_t i = 0; i < numEntities; ++i)
     {
-        const auto mesh = entity->mesh;
+        if (!(visible_[i / 32] & (1u << (i % 32))))
+        {
+            continue;
+        }
+
+        const auto& mesh = meshes_[i];
         if (!mesh.useable())
         {
             continue;
         }
 
         const auto vertexData = mesh->vertexData();
-        const auto world_T = entity->worldMatrix.transpose();
         for (auto subMeshes = mesh->subMeshes(); subMeshes.first != subMeshes.second; ++subMeshes.first)
         {
             auto& subMesh = *subMeshes.first;
@@ -66,7 +185,7 @@ void RenderWorld::draw(const RenderCamera& camera)
                 continue;
             }
 
-            subMesh.material->directNumeric(ShaderType::vertex, SystemMatParam::WORLD, &world_T, sizeof(Matrix44));
+            subMesh.material->directNumeric(ShaderType::vertex, SystemMatParam::WORLD, worldMatrices_[i].data(), sizeof(Affine34));
             subMesh.material->directNumeric(ShaderType::vertex, SystemMatParam::VIEW, &view_T, sizeof(Matrix44));
             subMesh.material->directNumeric(ShaderType::vertex, SystemMatParam::PROJ, &proj_T, sizeof(Matrix44));
 
@@ -155,6 +274,7 @@ void SceneAppContext::shutdown()
     copyCommands_.reset();
     graphicsCommandBuilder_.reset();
     frameResources_.clear();
+    frameAllocator_.release();
 
     GF_LOG_INFO("SceneManager shutdown.");
 }
@@ -179,6 +299,11 @@ PixelBuffer& SceneAppContext::backBuffer()
     return renderSystem.backBuffer(renderSystem.currentFrameIndex());
 }
 
+FrameAllocator& SceneAppContext::frameAllocator()
+{
+    return frameAllocator_;
+}
+
 void SceneAppContext::executeCommandsAndPresent()
 {
     graphicsCommandBuilder_->transition(backBuffer(), PixelBufferState::renderTarget, PixelBufferState::present);
@@ -209,6 +334,8 @@ void SceneAppContext::executeCommandsAndPresent()
 
     graphicsCommandBuilder_->transition(backBuffer(), PixelBufferState::present, PixelBufferState::renderTarget);
     graphicsCommandBuilder_->clearRenderTarget(backBuffer(), { 0, 0, 0, 1 });
+
+    frameAllocator_.nextFrame();
 }
 
 GF_NAMESPACE_END
\ No newline at end of file
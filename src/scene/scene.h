@@ -4,7 +4,10 @@
 #include "../render/gpucommand.h"
 #include "../render/renderstate.h"
 #include "../engine/resource.h"
-#include "foundation/sortedvector.h"
+#include "foundation/slotmap.h"
+#include "foundation/affine34.h"
+#include "foundation/axisalignedbox.h"
+#include "foundation/frameallocator.h"
 #include "foundation/matrix44.h"
 #include "foundation/prerequest.h"
 #include <memory>
@@ -19,9 +22,11 @@ class Mesh;
 struct RenderEntity
 {
     ResourceInterface<Mesh> mesh;
-    Matrix44 worldMatrix;
+    Affine34 worldMatrix;
 };
 
+using RenderEntityHandle = SlotHandle;
+
 struct RenderCamera
 {
     Matrix44 view;
@@ -29,17 +34,45 @@ struct RenderCamera
     Viewport viewport;
 };
 
+/// Render proxies held by value. Each field is an array in dense order, so draw() walks them contiguously.
 class RenderWorld
 {
 private:
-    SortedVector<std::shared_ptr<RenderEntity>> entities_;
+    SlotTable entities_;
+    std::vector<ResourceInterface<Mesh>> meshes_;
+    std::vector<Affine34> worldMatrices_;
+
+    /// World space bounds. Refreshed by draw() once the mesh is ready; infinite until then.
+    std::vector<float> boundsMinX_;
+    std::vector<float> boundsMinY_;
+    std::vector<float> boundsMinZ_;
+    std::vector<float> boundsMaxX_;
+    std::vector<float> boundsMaxY_;
+    std::vector<float> boundsMaxZ_;
+    std::vector<uint8> boundsDirty_;
+
+    std::vector<uint32> visible_;
 
 public:
-    void addEntity(const std::shared_ptr<RenderEntity>& entity);
-    void removeEntity(const std::shared_ptr<RenderEntity>& entity);
+    RenderEntityHandle addEntity(const RenderEntity& entity);
+    void removeEntity(RenderEntityHandle entity); /// Ignores stale handles
     void clearEntities();
 
+    bool containsEntity(RenderEntityHandle entity) const;
+    size_t numEntities() const;
+
+    const ResourceInterface<Mesh>& mesh(RenderEntityHandle entity) const;
+    void setMesh(RenderEntityHandle entity, const ResourceInterface<Mesh>& mesh);
+
+    const Affine34& worldMatrix(RenderEntityHandle entity) const;
+    void setWorldMatrix(RenderEntityHandle entity, const Affine34& m);
+
+    /// Frustum culled by the world bounds
     void draw(const RenderCamera& camera);
+
+private:
+    void setBounds(size_t i, const AxisAlignedBox& box);
+    void refreshBounds();
 };
 
 class SceneAppContext
@@ -58,6 +91,8 @@ private:
 
     std::unique_ptr<PixelBuffer> depthTarget_;
 
+    FrameAllocator frameAllocator_;
+
 public:
     void startup() noexcept(false);
     void shutdown();
@@ -68,6 +103,9 @@ public:
     PixelBuffer& depthTarget();
     PixelBuffer& backBuffer();
 
+    /// Reset by executeCommandsAndPresent(). Memory stays valid through the next frame.
+    FrameAllocator& frameAllocator();
+
     void executeCommandsAndPresent();
 };
 
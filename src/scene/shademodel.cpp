@@ -6,8 +6,8 @@
 GF_NAMESPACE_BEGIN
 
 ShadeModelInput::ShadeModelInput(std::shared_ptr<ShaderParameters>&& programParams, const OptimizedDrawCall& drawCall,
-    const std::unordered_multimap<std::string, detail::Mapping>& numericMappings,
-    const std::unordered_multimap<std::string, detail::Mapping>& textureMappings_)
+    const detail::MappingTable& numericMappings,
+    const detail::MappingTable& textureMappings_)
     : drawCall_(drawCall)
     , programParams_(std::move(programParams))
     , numericMappings_(numericMappings)
@@ -21,29 +21,31 @@ OptimizedDrawCall ShadeModelInput::drawCallSource() const
     return drawCall_;
 }
 
-void ShadeModelInput::updateNumeric(const std::string& name, const void* data, size_t size)
+void ShadeModelInput::updateNumeric(StringId name, const void* data, size_t size)
 {
-    auto range = numericMappings_.equal_range(name);
-    while (range.first != range.second)
+    const auto found = numericMappings_.find(name);
+    if (found != std::cend(numericMappings_))
     {
-        const auto mapping = range.first->second;
-        programParams_->updateConstant(mapping.toType, mapping.toName, data, std::min(size, mapping.maxSize));
-        ++range.first;
+        for (const auto& mapping : found->second)
+        {
+            programParams_->updateConstant(mapping.toType, mapping.toName, data, std::min(size, mapping.maxSize));
+        }
     }
 }
 
-void ShadeModelInput::updateTexture(const std::string& name, PixelBuffer& texture)
+void ShadeModelInput::updateTexture(StringId name, PixelBuffer& texture)
 {
-    auto range = textureMappings_.equal_range(name);
-    while (range.first != range.second)
+    const auto found = textureMappings_.find(name);
+    if (found != std::cend(textureMappings_))
     {
-        const auto mapping = range.first->second;
-        programParams_->updateShaderResource(mapping.toType, mapping.toName, texture);
-        ++range.first;
+        for (const auto& mapping : found->second)
+        {
+            programParams_->updateShaderResource(mapping.toType, mapping.toName, texture);
+        }
     }
 }
 
-void ShadeModelInput::directNumeric(ShaderType type, const std::string& name, const void* data, size_t size)
+void ShadeModelInput::directNumeric(ShaderType type, StringId name, const void* data, size_t size)
 {
     programParams_->updateConstant(type, name, data, size);
 }
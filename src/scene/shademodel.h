@@ -6,6 +6,9 @@
 #include "../render/drawcall.h"
 #include "../engine/resource.h"
 #include "../engine/filesystem.h"
+#include "foundation/hashmap.h"
+#include "foundation/stringref.h"
+#include "foundation/stringid.h"
 #include "foundation/prerequest.h"
 #include <memory>
 #include <vector>
@@ -20,8 +23,11 @@ namespace detail
     {
         size_t maxSize;
         ShaderType toType;
-        std::string toName;
+        StringId toName;
     };
+
+    /// One material parameter may feed several shader variables
+    using MappingTable = HashMap<StringId, std::vector<Mapping>>;
 }
 
 class ShadeModelInput
@@ -30,20 +36,20 @@ private:
     OptimizedDrawCall drawCall_;
     std::shared_ptr<ShaderParameters> programParams_;
 
-    const std::unordered_multimap<std::string, detail::Mapping>& numericMappings_;
-    const std::unordered_multimap<std::string, detail::Mapping>& textureMappings_;
+    const detail::MappingTable& numericMappings_;
+    const detail::MappingTable& textureMappings_;
 
 public:
     ShadeModelInput(std::shared_ptr<ShaderParameters>&& programParams, const OptimizedDrawCall& drawCallBase,
-        const std::unordered_multimap<std::string, detail::Mapping>& numericMappings,
-        const std::unordered_multimap<std::string, detail::Mapping>& textureMappings_);
+        const detail::MappingTable& numericMappings,
+        const detail::MappingTable& textureMappings_);
 
     OptimizedDrawCall drawCallSource() const;
 
-    void updateNumeric(const std::string& name, const void* data, size_t size);
-    void updateTexture(const std::string& name, PixelBuffer& texture);
+    void updateNumeric(StringId name, const void* data, size_t size);
+    void updateTexture(StringId name, PixelBuffer& texture);
 
-    void directNumeric(ShaderType type, const std::string& name, const void* data, size_t size);
+    void directNumeric(ShaderType type, StringId name, const void* data, size_t size);
 };
 
 class ShadeModel : public Resource
@@ -51,8 +57,8 @@ class ShadeModel : public Resource
 private:
     OptimizedDrawCall drawCall_;
     ShaderProgram program_;
-    std::unordered_multimap<std::string, detail::Mapping> numericMappings_;
-    std::unordered_multimap<std::string, detail::Mapping> textureMappings_;
+    detail::MappingTable numericMappings_;
+    detail::MappingTable textureMappings_;
     std::vector<std::pair<std::string, MatParamType>> params_;
 
 public:
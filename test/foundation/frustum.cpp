@@ -0,0 +1,71 @@
+#include "../test.h"
+#include "foundation/frustum.h"
+#include <cfloat>
+#include <limits>
+
+using namespace GF_NAMESPACE;
+
+namespace
+{
+    const size_t NUM_BOXES = 13;
+    const float INF = std::numeric_limits<float>::infinity();
+
+    /// The unit cube [-1, 1]^3 as six inward facing planes
+    Frustum makeUnitCube()
+    {
+        Frustum frustum;
+        frustum.planes[Frustum::LEFT] = Plane(Vector3(1, 0, 0), 1);
+        frustum.planes[Frustum::RIGHT] = Plane(Vector3(-1, 0, 0), 1);
+        frustum.planes[Frustum::BOTTOM] = Plane(Vector3(0, 1, 0), 1);
+        frustum.planes[Frustum::TOP] = Plane(Vector3(0, -1, 0), 1);
+        frustum.planes[Frustum::ZNEAR] = Plane(Vector3(0, 0, 1), 1);
+        frustum.planes[Frustum::ZFAR] = Plane(Vector3(0, 0, -1), 1);
+        return frustum;
+    }
+
+    bool bit(const uint32* mask, size_t i)
+    {
+        return (mask[i / 32] >> (i % 32) & 1) != 0;
+    }
+}
+
+int main()
+{
+    // Infinite bounds give 0 * inf = NaN distances, FLT_MAX ones overflow to inf.
+    // The pattern repeats every 5 boxes so each kind lands in scalar and SIMD lanes.
+    float minX[NUM_BOXES], minY[NUM_BOXES], minZ[NUM_BOXES];
+    float maxX[NUM_BOXES], maxY[NUM_BOXES], maxZ[NUM_BOXES];
+    const float mins[5] = { -0.5f, 5, -INF, -FLT_MAX, -INF };
+    const float maxs[5] = { 0.5f, 6, INF, FLT_MAX, -5 };
+    for (size_t i = 0; i < NUM_BOXES; ++i)
+    {
+        minX[i] = minY[i] = minZ[i] = mins[i % 5];
+        maxX[i] = maxY[i] = maxZ[i] = maxs[i % 5];
+    }
+    const AxisAlignedBoxArrays boxes = { minX, minY, minZ, maxX, maxY, maxZ };
+    const auto frustum = makeUnitCube();
+
+    // n = 5 takes the scalar path only, n = 13 runs a SIMD batch first
+    uint32 visibleScalar = 0;
+    uint32 intersectingScalar = 0;
+    cullBoxes(frustum, boxes, 5, &visibleScalar, &intersectingScalar);
+    uint32 visible = 0;
+    uint32 intersecting = 0;
+    cullBoxes(frustum, boxes, NUM_BOXES, &visible, &intersecting);
+
+    for (size_t i = 0; i < NUM_BOXES; ++i)
+    {
+        GF_TEST_CHECK(bit(&visible, i) == bit(&visibleScalar, i % 5));
+        GF_TEST_CHECK(bit(&intersecting, i) == bit(&intersectingScalar, i % 5));
+    }
+
+    // Inside, outside, and the non-finite ones that reach into the cube are kept
+    GF_TEST_CHECK(bit(&visibleScalar, 0) && !bit(&intersectingScalar, 0));
+    GF_TEST_CHECK(!bit(&visibleScalar, 1));
+    GF_TEST_CHECK(bit(&visibleScalar, 2));
+    GF_TEST_CHECK(bit(&visibleScalar, 3));
+    GF_TEST_CHECK(!bit(&visibleScalar, 4));
+
+    std::printf("frustum: ok\n");
+    return 0;
+}
\ No newline at end of file
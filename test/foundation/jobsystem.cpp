@@ -0,0 +1,120 @@
+#include "../test.h"
+#include "foundation/jobsystem.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace GF_NAMESPACE;
+
+namespace
+{
+    const int ITERATIONS = 20000;
+    const int NUM_WORK = 8;
+    const int NUM_ADDERS = 4;
+    const int NUM_CONTINUATIONS = 16;
+
+    /// Continuations are registered by jobs and by the main thread while the dependency completes.
+    /// A lost release hangs the last wait; counters are freed right after wait to expose late accesses.
+    struct Iteration
+    {
+        JobCounter dependency;
+        JobCounter adders;
+        JobCounter after;
+        std::atomic<int> ran;
+        std::atomic<int> next;
+        Job work[NUM_WORK];
+        Job adderJobs[NUM_ADDERS];
+        Job continuations[NUM_CONTINUATIONS];
+
+        Iteration()
+            : ran(0)
+            , next(0)
+        {
+            for (auto& job : work)
+            {
+                job = Job{ &Iteration::spin, this, nullptr };
+            }
+            for (auto& job : adderJobs)
+            {
+                job = Job{ &Iteration::addContinuation, this, nullptr };
+            }
+        }
+
+        static void spin(void*)
+        {
+            for (volatile int i = 0; i < 50; ++i)
+            {
+            }
+        }
+
+        static void count(void* data)
+        {
+            static_cast<Iteration*>(data)->ran.fetch_add(1);
+        }
+
+        static void addContinuation(void* data)
+        {
+            auto& it = *static_cast<Iteration*>(data);
+            const auto index = it.next.fetch_add(1);
+            it.continuations[index] = Job{ &Iteration::count, &it, nullptr };
+            jobSystem.runAfter(it.dependency, it.continuations[index], it.after);
+        }
+    };
+
+    std::atomic<bool> finished(false);
+
+    void watchdog()
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (!finished.load())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                std::fprintf(stderr, "jobsystem: timed out, a continuation was lost\n");
+                std::_Exit(1);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+int main()
+{
+    std::thread guard(watchdog);
+    jobSystem.startup(4);
+
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        auto it = std::make_unique<Iteration>();
+        jobSystem.run(it->work, NUM_WORK, it->dependency);
+        jobSystem.run(it->adderJobs, NUM_ADDERS, it->adders);
+        for (int c = 0; c < NUM_CONTINUATIONS - NUM_ADDERS; ++c)
+        {
+            Iteration::addContinuation(it.get());
+        }
+
+        jobSystem.wait(it->adders);
+        jobSystem.wait(it->dependency);
+        jobSystem.wait(it->after);
+        GF_TEST_CHECK(it->ran.load() == NUM_CONTINUATIONS);
+    }
+
+    // Continuations on a counter that is already done run at once
+    {
+        JobCounter dependency;
+        JobCounter after;
+        Iteration it;
+        it.continuations[0] = Job{ &Iteration::count, &it, nullptr };
+        jobSystem.runAfter(dependency, it.continuations[0], after);
+        jobSystem.wait(after);
+        GF_TEST_CHECK(it.ran.load() == 1);
+    }
+
+    jobSystem.shutdown();
+    finished.store(true);
+    guard.join();
+
+    std::printf("jobsystem: ok\n");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "../test.h"
+#include "foundation/metaprop.h"
+#include "foundation/metapropbinary.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GF_NAMESPACE;
+
+namespace
+{
+    const char* const PATH = "metaprop_test.txt";
+    const char* const BINARY_PATH = "metaprop_test.bin";
+    const int NUM_GROUPS = 64;
+    const int NUM_VALUES = 32;
+    const int NUM_THREADS = 8;
+
+    void writeSource()
+    {
+        std::ofstream out(PATH, std::ios_base::out | std::ios_base::trunc);
+        out << "@_Header\nAuther: test\nComment: \"indexed reads\"\n";
+        for (int g = 0; g < NUM_GROUPS; ++g)
+        {
+            out << "@Group" << g << "\nValues:";
+            for (int v = 0; v < NUM_VALUES; ++v)
+            {
+                out << ' ' << g * NUM_VALUES + v;
+            }
+            out << "\n";
+        }
+    }
+
+    /// Every thread reads the same properties of the same groups, which are parsed on the first get()
+    void concurrentIndexedReads()
+    {
+        MetaPropFile file;
+        file.readIndexed(PATH);
+
+        std::atomic<int> bad(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NUM_THREADS; ++t)
+        {
+            threads.emplace_back([&file, &bad, t]
+            {
+                for (int k = 0; k < NUM_GROUPS; ++k)
+                {
+                    const auto g = (k + t) % NUM_GROUPS;
+                    const auto& prop = file.get("Group" + std::to_string(g)).get("Values");
+                    uint32 parsed[NUM_VALUES];
+                    if (prop.size() != NUM_VALUES || prop.parse(parsed, NUM_VALUES) != NUM_VALUES)
+                    {
+                        ++bad;
+                        continue;
+                    }
+                    for (int v = 0; v < NUM_VALUES; ++v)
+                    {
+                        const auto expected = static_cast<uint32>(g * NUM_VALUES + v);
+                        if (parsed[v] != expected || prop.get(v) != std::to_string(expected))
+                        {
+                            ++bad;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        GF_TEST_CHECK(bad.load() == 0);
+        GF_TEST_CHECK(file.auther() == "test");
+    }
+
+    bool sameFloat(float a, float b)
+    {
+        return std::isnan(a) ? std::isnan(b) : std::memcmp(&a, &b, sizeof(a)) == 0;
+    }
+
+    /// Values written by setArray() and set() read back bit for bit, non-finite ones included
+    void floatRoundTrip()
+    {
+        const float values[] =
+        {
+            0.0f, -0.0f, 1.5f, -0.1f, 3.4028235e38f, 1.17549435e-38f, 1.4e-45f, 16777217.0f,
+            std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::quiet_NaN()
+        };
+        const size_t n = sizeof(values) / sizeof(values[0]);
+
+        MetaProperty array("Array");
+        array.setArray(values, n);
+        MetaProperty each("Each");
+        for (size_t i = 0; i < n; ++i)
+        {
+            each.set(i, values[i]);
+        }
+
+        MetaPropGroup group("Floats");
+        group.add(array);
+        group.add(each);
+        MetaPropFile written;
+        written.add(group);
+        written.write(PATH);
+
+        MetaPropFile file;
+        file.read(PATH);
+        for (const auto name : { "Array", "Each" })
+        {
+            float parsed[n];
+            GF_TEST_CHECK(file.get("Floats").get(name).parse(parsed, n) == n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                GF_TEST_CHECK(sameFloat(parsed[i], values[i]));
+            }
+        }
+    }
+
+    /// Doubles are written with the fewest digits that stod() reads back bit for bit
+    void doubleRoundTrip()
+    {
+        const double values[] =
+        {
+            0.0, -0.0, 0.1, 100, 1.0 / 3, 123456789012345678.0, 1e300, std::numeric_limits<double>::min(),
+            std::numeric_limits<double>::max(), -std::numeric_limits<double>::infinity()
+        };
+        const size_t n = sizeof(values) / sizeof(values[0]);
+
+        MetaProperty prop("Doubles");
+        for (size_t i = 0; i < n; ++i)
+        {
+            prop.set(i, values[i]);
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto parsed = prop.stod(i);
+            GF_TEST_CHECK(std::memcmp(&parsed, &values[i], sizeof(parsed)) == 0);
+        }
+        GF_TEST_CHECK(prop.get(2) == "0.1");
+        GF_TEST_CHECK(prop.get(3) == "100");
+
+        prop.set(0, std::numeric_limits<double>::quiet_NaN());
+        GF_TEST_CHECK(std::isnan(prop.stod(0)));
+    }
+
+    /// writeBinary() picks a numeric type only when the values read back as written
+    void binaryRoundTrip()
+    {
+        struct Case
+        {
+            const char* name;
+            std::vector<std::string> values;
+            MetaPropType type;
+        };
+        const Case cases[] =
+        {
+            { "Short", { "0", "7", "65535" }, MetaPropType::_uint16 },
+            { "Long", { "65536", "4294967295" }, MetaPropType::_uint32 },
+            { "Float", { "0.1", "-5", "1.5", "16777216", "3.4028235e+38" }, MetaPropType::_float32 },
+            { "LeadingZero", { "001" }, MetaPropType::_string },
+            { "TrailingZero", { "1.10" }, MetaPropType::_string },
+            { "TooLong", { "12345678901" }, MetaPropType::_string },
+            { "Unrepresentable", { "16777217", "1.5" }, MetaPropType::_string },
+            { "Plus", { "+5" }, MetaPropType::_string },
+        };
+
+        MetaPropGroup group("Values");
+        for (const auto& c : cases)
+        {
+            MetaProperty prop(c.name);
+            for (size_t i = 0; i < c.values.size(); ++i)
+            {
+                prop[i] = c.values[i];
+            }
+            group.add(prop);
+        }
+        MetaPropFile written;
+        written.add(group);
+        written.writeBinary(BINARY_PATH);
+
+        BinaryMetaPropFile file(BINARY_PATH);
+        for (const auto& c : cases)
+        {
+            const auto prop = file.get("Values").get(c.name);
+            GF_TEST_CHECK(prop.type() == c.type);
+            GF_TEST_CHECK(prop.size() == c.values.size());
+            for (size_t i = 0; i < c.values.size(); ++i)
+            {
+                GF_TEST_CHECK(prop.get(i) == c.values[i]);
+            }
+        }
+        file.close();
+    }
+}
+
+int main()
+{
+    writeSource();
+    concurrentIndexedReads();
+    floatRoundTrip();
+    doubleRoundTrip();
+    binaryRoundTrip();
+    std::remove(PATH);
+    std::remove(BINARY_PATH);
+
+    std::printf("metaprop: ok\n");
+    return 0;
+}
\ No newline at end of file
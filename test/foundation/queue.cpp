@@ -0,0 +1,96 @@
+#include "../test.h"
+#include "foundation/mpmcqueue.h"
+#include "foundation/spscqueue.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace GF_NAMESPACE;
+
+namespace
+{
+    const int NUM_THREADS = 4;
+    const int PER_THREAD = 20000;
+
+    template <class Queue>
+    bool throwsOnCapacity(size_t capacity)
+    {
+        try
+        {
+            Queue queue(capacity);
+        }
+        catch (const std::length_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+}
+
+int main()
+{
+    GF_TEST_CHECK(MpmcQueue<int>(0).capacity() == 2);
+    GF_TEST_CHECK(MpmcQueue<int>(5).capacity() == 8);
+    GF_TEST_CHECK(SpscQueue<int>(8).capacity() == 8);
+    GF_TEST_CHECK(throwsOnCapacity<MpmcQueue<int>>(static_cast<size_t>(-1)));
+    GF_TEST_CHECK(throwsOnCapacity<SpscQueue<int>>(detail::MAX_QUEUE_CAPACITY + 1));
+
+    // Blocking push and pop through a small queue, so both sides keep waiting on each other
+    {
+        MpmcQueue<int> queue(4);
+        std::atomic<long long> sum(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NUM_THREADS; ++t)
+        {
+            threads.emplace_back([&queue]
+            {
+                for (int i = 1; i <= PER_THREAD; ++i)
+                {
+                    queue.push(i);
+                }
+            });
+            threads.emplace_back([&queue, &sum]
+            {
+                long long local = 0;
+                for (int i = 0; i < PER_THREAD; ++i)
+                {
+                    int val;
+                    queue.pop(val);
+                    local += val;
+                }
+                sum.fetch_add(local);
+            });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        GF_TEST_CHECK(sum.load() == static_cast<long long>(PER_THREAD) * (PER_THREAD + 1) / 2 * NUM_THREADS);
+        GF_TEST_CHECK(queue.empty());
+    }
+
+    // Order is kept from a single producer
+    {
+        SpscQueue<int> queue(4);
+        std::thread producer([&queue]
+        {
+            for (int i = 0; i < PER_THREAD; ++i)
+            {
+                queue.push(i);
+            }
+        });
+        bool ordered = true;
+        for (int i = 0; i < PER_THREAD; ++i)
+        {
+            int val;
+            queue.pop(val);
+            ordered = ordered && val == i;
+        }
+        producer.join();
+        GF_TEST_CHECK(ordered);
+    }
+
+    std::printf("queue: ok\n");
+    return 0;
+}
\ No newline at end of file
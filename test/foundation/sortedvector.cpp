@@ -0,0 +1,58 @@
+#include "../test.h"
+#include "foundation/sortedvector.h"
+#include "foundation/flatmap.h"
+#include <utility>
+#include <vector>
+
+using namespace GF_NAMESPACE;
+
+namespace
+{
+    using Entry = std::pair<int, char>;
+
+    struct KeyComp
+    {
+        bool operator ()(const Entry& a, const Entry& b) const
+        {
+            return a.first < b.first;
+        }
+    };
+
+    bool sameEntries(const SortedVector<Entry, KeyComp>& v, const std::vector<Entry>& expected)
+    {
+        return v.size() == expected.size() && std::equal(std::begin(v), std::end(v), std::begin(expected));
+    }
+}
+
+int main()
+{
+    // Existing equivalent elements are all kept and win over new ones
+    SortedVector<Entry, KeyComp> multi;
+    multi.insert(Entry(1, 'a'));
+    multi.insert(Entry(1, 'b'));
+    multi.insert(Entry(3, 'a'));
+    multi.insert(Entry(3, 'b'));
+    const Entry added[] = { { 5, 'n' }, { 1, 'n' }, { 2, 'n' }, { 3, 'n' }, { 2, 'm' }, { 0, 'n' }, { 5, 'm' } };
+    multi.insertUnique(std::begin(added), std::end(added));
+    GF_TEST_CHECK(sameEntries(multi, { { 0, 'n' }, { 1, 'a' }, { 1, 'b' }, { 2, 'n' }, { 3, 'a' }, { 3, 'b' }, { 5, 'n' } }));
+
+    // Nothing new
+    multi.insertUnique(std::begin(added), std::begin(added) + 2);
+    GF_TEST_CHECK(multi.size() == 7);
+
+    // Into an empty vector
+    SortedVector<Entry, KeyComp> empty;
+    empty.insertUnique(std::begin(added), std::end(added));
+    GF_TEST_CHECK(sameEntries(empty, { { 0, 'n' }, { 1, 'n' }, { 2, 'n' }, { 3, 'n' }, { 5, 'n' } }));
+
+    // Same for the unique containers built on it
+    FlatMap<int, char> map;
+    map.insert(std::make_pair(2, 'a'));
+    map.insert({ std::make_pair(1, 'n'), std::make_pair(2, 'n'), std::make_pair(1, 'm') });
+    GF_TEST_CHECK(map.size() == 2);
+    GF_TEST_CHECK(map.find(1)->second == 'n');
+    GF_TEST_CHECK(map.find(2)->second == 'a');
+
+    std::printf("sortedvector: ok\n");
+    return 0;
+}
\ No newline at end of file
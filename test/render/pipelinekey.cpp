@@ -0,0 +1,95 @@
+#include "../test.h"
+#include "../../src/render/pipelinekey.h"
+#include <cstring>
+#include <vector>
+
+using namespace GF_NAMESPACE;
+
+namespace
+{
+    PipelineStateKey makeKey(const D3D12_SHADER_BYTECODE& vs, const D3D12_INPUT_LAYOUT_DESC& layout, DXGI_FORMAT rtv)
+    {
+        PipelineStateKey key;
+        std::memset(&key, 0, sizeof(key));
+        key.state.VS = vs;
+        key.state.InputLayout.pInputElementDescs = layout.pInputElementDescs; // Keeps the padding zero
+        key.state.InputLayout.NumElements = layout.NumElements;
+        key.state.NumRenderTargets = 1;
+        key.state.RTVFormats[0] = rtv;
+        key.vs = hashShaderBytecode(vs);
+        key.inputLayout = hashInputLayout(layout);
+        key.hash = hashTargetState(key, hashShaderState(key));
+        return key;
+    }
+
+    D3D12_INPUT_LAYOUT_DESC layoutOf(const std::vector<D3D12_INPUT_ELEMENT_DESC>& elems)
+    {
+        D3D12_INPUT_LAYOUT_DESC layout = {};
+        layout.NumElements = static_cast<UINT>(elems.size());
+        layout.pInputElementDescs = elems.data();
+        return layout;
+    }
+}
+
+int main()
+{
+    const char codeA[] = "vertex shader A";
+    const char codeB[] = "vertex shader A";
+    const D3D12_SHADER_BYTECODE vsA = { codeA, sizeof(codeA) };
+    const D3D12_SHADER_BYTECODE vsB = { codeB, sizeof(codeB) };
+    const D3D12_SHADER_BYTECODE empty = {};
+
+    GF_TEST_CHECK(hashShaderBytecode(empty) == 0);
+    GF_TEST_CHECK(hashShaderBytecode(vsA) == hashShaderBytecode(vsB));
+
+    // Equal layouts in different storage intern to the same elements
+    char semantic[] = "POSITION";
+    D3D12_INPUT_ELEMENT_DESC elem = {};
+    elem.SemanticName = "POSITION";
+    elem.Format = DXGI_FORMAT_R32G32B32_FLOAT;
+    std::vector<D3D12_INPUT_ELEMENT_DESC> elems1(1, elem);
+    std::vector<D3D12_INPUT_ELEMENT_DESC> elems2(1, elem);
+    elems2[0].SemanticName = semantic;
+    std::vector<D3D12_INPUT_ELEMENT_DESC> elems3(1, elem);
+    elems3[0].Format = DXGI_FORMAT_R32G32_FLOAT;
+
+    const auto layout1 = internInputLayout(layoutOf(elems1), hashInputLayout(layoutOf(elems1)));
+    const auto layout2 = internInputLayout(layoutOf(elems2), hashInputLayout(layoutOf(elems2)));
+    const auto layout3 = internInputLayout(layoutOf(elems3), hashInputLayout(layoutOf(elems3)));
+    GF_TEST_CHECK(layout1.NumElements == 1);
+    GF_TEST_CHECK(layout1.pInputElementDescs != elems1.data());
+    GF_TEST_CHECK(layout1.pInputElementDescs == layout2.pInputElementDescs);
+    GF_TEST_CHECK(layout1.pInputElementDescs != layout3.pInputElementDescs);
+    GF_TEST_CHECK(hashInputLayout(layout1) == hashInputLayout(layoutOf(elems1)));
+
+    // A layout colliding with another's hash still interns separately
+    const auto collided = internInputLayout(layoutOf(elems3), hashInputLayout(layoutOf(elems1)));
+    GF_TEST_CHECK(collided.pInputElementDescs != layout1.pInputElementDescs);
+    GF_TEST_CHECK(std::memcmp(collided.pInputElementDescs, elems3.data(), sizeof(elem)) == 0);
+
+    const auto a = makeKey(vsA, layout1, DXGI_FORMAT_R8G8B8A8_UNORM);
+    const auto same = makeKey(vsA, layout2, DXGI_FORMAT_R8G8B8A8_UNORM);
+    GF_TEST_CHECK(a == same);
+    GF_TEST_CHECK(a.hash == same.hash);
+    GF_TEST_CHECK(PrecomputedHash()(a) == PrecomputedHash()(same));
+
+    const auto otherTarget = makeKey(vsA, layout1, DXGI_FORMAT_R16G16B16A16_FLOAT);
+    GF_TEST_CHECK(a != otherTarget);
+    GF_TEST_CHECK(a.hash != otherTarget.hash);
+
+    const auto otherLayout = makeKey(vsA, layout3, DXGI_FORMAT_R8G8B8A8_UNORM);
+    GF_TEST_CHECK(a != otherLayout);
+    GF_TEST_CHECK(a.hash != otherLayout.hash);
+
+    // Same digests and hash, different shader: a collision must not make the keys equal
+    auto otherShader = makeKey(vsB, layout1, DXGI_FORMAT_R8G8B8A8_UNORM);
+    GF_TEST_CHECK(otherShader.hash == a.hash);
+    GF_TEST_CHECK(a != otherShader);
+
+    auto otherLayoutCollided = a;
+    otherLayoutCollided.state.InputLayout.pInputElementDescs = layout3.pInputElementDescs;
+    GF_TEST_CHECK(a != otherLayoutCollided);
+
+    std::printf("pipelinekey: ok\n");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef GAMEFRIENDS_TEST_H
+#define GAMEFRIENDS_TEST_H
+
+#include <cstdio>
+#include <cstdlib>
+
+/// Each test is one program built with the source files it covers and foundation/src on the include path.
+/// A failed check prints its location and exits with 1.
+#define GF_TEST_CHECK(cond) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            std::fprintf(stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #cond); \
+            std::exit(1); \
+        } \
+    } while (false)
+
+#endif
\ No newline at end of file